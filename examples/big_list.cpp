@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <string_view>
+#include "../include/tty-cpp.hpp"
+
+/**
+ * @brief Scrolls through a table of ten million generated rows until q is pressed.
+ *
+ * @details Term::TableView only asks for the rows on screen, formatted into the frame arena, so moving around
+ * costs the same anywhere in the list. Arrows move the selection, PAGE UP/DOWN, HOME and END jump.
+ */
+int main() {
+    RawModeGuard raw_mode_guard;
+    Cursor::hide();
+
+    Term::TableView view({"#", "name", "size"}, [](std::size_t row, std::string_view* cells) {
+        Term::Arena& arena = Term::frame_arena();
+        char number[32];
+        int length = std::snprintf(number, sizeof(number), "%zu", row);
+        cells[0] = arena.copy(std::string_view(number, static_cast<std::size_t>(length)));
+        cells[1] = arena.concat({"file-", cells[0], row % 7 == 0 ? ".tar.gz" : ".txt"});
+        length = std::snprintf(number, sizeof(number), "%zu KB", row * 7919 % 100000);
+        cells[2] = arena.copy(std::string_view(number, static_cast<std::size_t>(length)));
+    });
+    view.table().set_align(0, Term::Table::Align::RIGHT);
+    view.table().set_align(2, Term::Table::Align::RIGHT);
+    view.set_row_count(10000000);
+
+    Term::Renderer renderer;
+    for (;;) {
+        view.draw(renderer.buffer(), 0, 0, renderer.rows());
+        renderer.present();
+
+        const Term::Event event = Term::getevent();
+        if (event.type == Term::EventType::RESIZE) {
+            renderer.resize(event.rows, event.columns);
+            continue;
+        }
+        if (event.type != Term::EventType::KEY || event.key == Key::q || event.key == Key::CTRL_C)
+            break;
+
+        const long page = static_cast<long>(view.page());
+        switch (event.key) {
+        case Key::UP_ARROW: view.move_selection(-1); break;
+        case Key::DOWN_ARROW: view.move_selection(1); break;
+        case Key::PAGE_UP: view.move_selection(-page); break;
+        case Key::PAGE_DOWN: view.move_selection(page); break;
+        case Key::HOME: view.select(0); break;
+        case Key::END: view.select(view.row_count() - 1); break;
+        default: break;
+        }
+    }
+
+    Screen::clear();
+    Cursor::show();
+
+    return 0;
+}
@@ -1,107 +1,35 @@
 // Bresenham's line algorithm
 #include "../include/tty-cpp.hpp"
 #include <iostream>
-#include <string>
-#include <cmath>
-
-void plot_line_low(int x0, int y0, 
-                   int x1, int y1,
-                   const std::string& ch) {
-    int dx = x1 - x0;
-    int dy = y1 - y0;
-    int yi = 1;
-
-    if (dy < 0) {
-        yi = -1;
-        dy = -dy;
-    }
-    int D = (2 * dy) - dx;
-    int y = y0;
-
-    for (int x = x0; x < x1; x++) {
-        Cursor::set(y, x);
-        std::cout << ch << std::flush;
-
-        if (D > 0) {
-            y += yi;
-            D += 2 * (dy - dx);
-        } else {
-            D += 2 * dy;
-        }
-    }
-}
-
-void plot_line_high(int x0, int y0, 
-                    int x1, int y1, 
-                    const std::string& ch) {
-    int dx = x1 - x0;
-    int dy = y1 - y0;
-    int xi = 1;
-    if (dx < 0) {
-        xi = -1;
-        dx = -dx;
-    }
-    int D = (2 * dx) - dy;
-    int x = x0;
-    
-    for (int y = y0; y < y1; y++) {
-        Cursor::set(y, x);
-        std::cout << ch << std::flush;
-        
-        if (D > 0) {
-            x += xi;
-            D += 2 * (dx - dy);
-        } else {
-            D += 2 * dx;
-        }
-    }
-}
-
-
-void plot_line(int x0, int y0, 
-               int x1, int y1,
-               const std::string& ch = "#") {
-    cursor_pos_t oldpos = Cursor::position();
-
-    if (abs(int(y1 - y0)) < abs(int(x1 - x0))) {
-        if (x0 > x1) {
-            plot_line_low(x1+oldpos.column, y1+oldpos.row, x0+oldpos.column, y0+oldpos.row, ch);
-        } else {
-            plot_line_low(x0+oldpos.column, y0+oldpos.row, x1+oldpos.column, y1+oldpos.row, ch);
-        }
-    } else {
-        if (y0 > y1) {
-            plot_line_high(x1+oldpos.column, y1+oldpos.row, x1+oldpos.column, y0+oldpos.row, ch);
-        } else {
-            plot_line_high(x0+oldpos.column, y0+oldpos.row, x1+oldpos.column, y1+oldpos.row, ch);
-        }
-    }
-
-    Cursor::set(oldpos);
-}
 
 int main() {
     try {
-    Screen::clear();
+    Term::Renderer renderer;
+    Term::CellBuffer& buffer = renderer.buffer();
+    const Term::CellStyle bold = Term::CellStyle().with(Term::Style::BOLD);
 
     // tty-cpp version and link to the repo
-    std::cout << Term::style(Term::Style::BOLD) << "Running tty-cpp version: " << Term::style(Term::Style::RESET) << Term::VERSION 
-              << Term::style(Term::Style::BOLD) << "\nRepo: " << Term::style(Term::Style::RESET) << Term::REPO 
-              << std::endl << std::endl;
+    std::size_t column = buffer.print(0, 0, "Running tty-cpp version: ", bold);
+    buffer.print(0, column, Term::VERSION);
+    column = buffer.print(1, 0, "Repo: ", bold);
+    buffer.print(1, column, Term::REPO);
 
     if (Term::stdout_connected()) 
-        std::cout << Term::color_fg(Term::ColorBit4::GREEN) << "Standard output is attached to a terminal." 
-                  << std::endl << std::endl;
+        buffer.print(3, 0, "Standard output is attached to a terminal.", Term::CellStyle(Term::ColorBit4::GREEN));
     else
-        std::cout << Term::color_fg(Term::ColorBit4::RED) << "Standard output is not attached to a terminal." 
-                  << std::endl << std::endl;
-    
-    std::cout << Term::color_fg(Term::ColorBit4::DEFAULT);
-
-    plot_line(0, 5, 10, 5);
-    plot_line(5, 0, 5, 11);
-
-    Cursor::next_line(10);
+        buffer.print(3, 0, "Standard output is not attached to a terminal.", Term::CellStyle(Term::ColorBit4::RED));
+
+    // a cross 12 cells high, 4x the vertical and 2x the horizontal resolution of plotting characters
+    Term::Canvas canvas(12, 24, Term::Canvas::Mode::BRAILLE);
+    // Term::draw_line is Bresenham's, plotting into the canvas and not the terminal
+    Term::draw_line(canvas, {0, 20}, {40, 20});
+    Term::draw_line(canvas, {20, 0}, {20, 44});
+    Term::draw_line(canvas, {0, 0}, {47, 47});
+    Term::draw_circle(canvas, {20, 20}, 12);
+    canvas.compose(buffer, 5, 0);
+    renderer.present();
+
+    Cursor::set(5 + canvas.rows() + 1, 1);
     std::cout << std::endl;
 
     } catch (const Term::Exception& re) {
@@ -5,22 +5,15 @@
 int main() {
     try {
     // tty-cpp version and link to the repo
-    std::cout << Term::style(Term::Style::BOLD) << "Running tty-cpp version: " << Term::style(Term::Style::RESET) << Term::VERSION 
-              << Term::style(Term::Style::BOLD) << "\nRepo: " << Term::style(Term::Style::RESET) << Term::REPO 
-              << std::endl << std::endl;
+    Term::print(TERM_MARKUP("{bold}Running tty-cpp version:{/} {}\n{bold}Repo:{/} {}\n\n"), Term::VERSION, Term::REPO);
 
-    if (Term::stdout_connected()) 
-        std::cout << Term::color_fg(Term::ColorBit4::GREEN) << "Standard output is attached to a terminal." << std::endl << std::endl;
+    if (Term::stdout_connected())
+        Term::print(TERM_MARKUP("{green}Standard output is attached to a terminal.{/}\n\n"));
     else
-        std::cout << Term::color_fg(Term::ColorBit4::RED) << "Standard output is not attached to a terminal." << std::endl << std::endl;
+        Term::print(TERM_MARKUP("{red}Standard output is not attached to a terminal.{/}\n\n"));
 
-    std::string text = "Some text with " + color_fg(Term::ColorBit4::RED) + color_bg(Term::ColorBit4::GREEN) + "red on green" + color_bg(Term::ColorBit4::DEFAULT) + color_fg(Term::ColorBit4::DEFAULT);
-    text += " and some " + style(Term::Style::BOLD) + "bold text" + style(Term::Style::RESET) + ".\n";
-    text += "𝓤𝓷𝓲𝓬𝓸𝓭𝓮 𝔀𝓸𝓻𝓴𝓼 𝓽𝓸𝓸";
-    std::cout << text << std::endl;
-
-    std::string rgb_text = "Some Text in " + Term::color_fg(255, 0, 0) + 'R' + Term::color_fg(0, 255, 0) + 'G' + Term::color_fg(0, 0, 255) + 'B' + Term::color_fg(Term::ColorBit4::DEFAULT);
-    std::cout << rgb_text << std::endl;
+    Term::print(TERM_MARKUP("Some text with {red bg:green}red on green{/} and some {bold}bold text{/}.\n𝓤𝓷𝓲𝓬𝓸𝓭𝓮 𝔀𝓸𝓻𝓴𝓼 𝓽𝓸𝓸\n"));
+    Term::print(TERM_MARKUP("Some Text in {#ff0000}R{#00ff00}G{#0000ff}B{/}\n"));
 
     std::cout << "A color chart: \n";
     for (std::uint8_t i = 0; i < 255; i += 3) { std::cout << Term::color_bg(i, 0, 0) << " " << Term::color_bg(Term::ColorBit4::DEFAULT); }
@@ -6,45 +6,42 @@
 /**
  * @brief Fills the screen with a given character and color.
  *
+ * @param renderer The renderer drawing to the screen.
  * @param c The character to fill the screen with.
  * @param color The color to use for filling the screen. Default value is no color.
  *
  * @details This function fills the entire screen with the specified character and color (if provided).
+ * The renderer collapses each row of identical cells into a single erase (ECH/EL) or repeat (REP), so a
+ * fill costs a few bytes per row instead of a color escape and a character per cell.
  *
  * Usage:
  *  - To fill the screen with a character and color:
- *      - fill_screen('x', Term::rgb(255, 0, 0)); // fills the screen with red 'x'
- *      - fill_screen('-', Term::ColorBit4::Blue); // fills the screen with blue '-'
+ *      - fill_screen(renderer, 'x', Term::rgb(255, 0, 0)); // fills the screen with red 'x'
+ *      - fill_screen(renderer, '-', Term::ColorBit4::Blue); // fills the screen with blue '-'
  *  - To fill the screen with a character and no color:
- *      - fill_screen('*'); // fills the screen with '*' in the default background color
+ *      - fill_screen(renderer, '*'); // fills the screen with '*' in the default background color
  *
  */
-void fill_screen(char c, std::variant<std::monostate, Term::rgb, Term::ColorBit4> color = std::variant<std::monostate, Term::rgb, Term::ColorBit4>{}) {
-    Screen::clear();
-    Screen::Size term_size = Screen::size();
-    
-    std::string fill_color = "";
+void fill_screen(Term::Renderer& renderer, char c, std::variant<std::monostate, Term::rgb, Term::ColorBit4> color = std::variant<std::monostate, Term::rgb, Term::ColorBit4>{}) {
+    Term::Color fill_color;
 
     if (!std::holds_alternative<std::monostate>(color)) {
         if (std::holds_alternative<Term::rgb>(color)) {
-            fill_color = Term::color_bg(std::get<Term::rgb>(color));
+            fill_color = std::get<Term::rgb>(color);
         } else {
-            fill_color = Term::color_bg(std::get<Term::ColorBit4>(color));
+            fill_color = std::get<Term::ColorBit4>(color);
         }
     }
 
-    for (int y = 0; y < term_size.columns; y++) {
-        for (int x = 0; x < term_size.rows; x++) {
-            std::cout << fill_color << c;
-        }
-    }
-
-    Cursor::home();
+    Term::CellBuffer& buffer = renderer.buffer();
+    buffer.fill(0, 0, buffer.rows(), buffer.columns(), Term::Cell{static_cast<char32_t>(c), Term::CellStyle(Term::Color(), fill_color)});
+    renderer.present();
 }
 
 /**
  * @brief Fills the screen with a given character and RGB color.
  *
+ * @param renderer The renderer drawing to the screen.
  * @param c The character to fill the screen with.
  * @param r The red component of the RGB color.
  * @param g The green component of the RGB color.
@@ -54,21 +51,26 @@ void fill_screen(char c, std::variant<std::monostate, Term::rgb, Term::ColorBit4
  *
  * Usage:
  *  - To fill the screen with a character and RGB color:
- *      - fill_screen('x', 255, 0, 0); // fills the screen with red 'x'
- *      - fill_screen('-', 0, 0, 255); // fills the screen with blue '-'
+ *      - fill_screen(renderer, 'x', 255, 0, 0); // fills the screen with red 'x'
+ *      - fill_screen(renderer, '-', 0, 0, 255); // fills the screen with blue '-'
  *
  */
-void fill_screen(char c, size_t r, size_t g, size_t b) { 
-    fill_screen(c, Term::rgb(r, g, b)); 
+void fill_screen(Term::Renderer& renderer, char c, size_t r, size_t g, size_t b) { 
+    fill_screen(renderer, c, Term::rgb(r, g, b)); 
 }
 
 int main() {
     RawModeGuard raw_mode_guard;
     Cursor::hide();
 
-    fill_screen(' ');
+    Term::Renderer renderer;
+    fill_screen(renderer, ' ');
 
-    for(;;) if (Term::keyhit()) break;
+    // redraw at the new size whenever the terminal is resized, stop on any key
+    for (Term::Event event = Term::getevent(); event.type == Term::EventType::RESIZE; event = Term::getevent()) {
+        renderer.resize(event.rows, event.columns);
+        fill_screen(renderer, ' ');
+    }
 
     Cursor::show();
 
@@ -0,0 +1,37 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include "../include/tty-cpp.hpp"
+
+/**
+ * @brief Tails a fake log under a fixed header until a key is pressed.
+ *
+ * @details Every new line scrolls the log pane with Term::CellBuffer::scroll(), so the renderer moves the
+ * pane with a scroll region (DECSTBM + SU) and only the new bottom line is written, instead of every line.
+ */
+int main() {
+    RawModeGuard raw_mode_guard;
+    Cursor::hide();
+
+    Term::Renderer renderer;
+    Term::CellBuffer& buffer = renderer.buffer();
+    const Term::CellStyle header(Term::ColorBit4::BLACK, Term::ColorBit4::CYAN);
+
+    buffer.fill(0, 0, 1, buffer.columns(), Term::Cell{U' ', header});
+    buffer.print(0, 1, "log_tail - press any key to quit", header.with(Term::Style::BOLD));
+
+    for (std::size_t line = 0; !Term::keyhit(); line++) {
+        const std::size_t bottom = buffer.rows() - 1;
+        buffer.scroll(1, buffer.rows(), 1);
+        buffer.print(bottom, 0, "[" + std::to_string(line) + "] request served");
+        renderer.present();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    Term::getkey();
+
+    Screen::clear();
+    Cursor::show();
+
+    return 0;
+}
@@ -40,15 +40,12 @@ int main() {
     RawModeGuard raw_mode_guard;
     Cursor::hide();
 
-    std::cout << Term::style(Term::Style::BOLD) << "Running tty-cpp version: " << Term::style(Term::Style::RESET) << Term::VERSION 
-              << Term::style(Term::Style::BOLD) << "\nRepo: " << Term::style(Term::Style::RESET) << Term::REPO 
-              << std::endl << std::endl;
+    Term::print(TERM_MARKUP("{bold}Running tty-cpp version:{/} {}\n{bold}Repo:{/} {}\n\n"), Term::VERSION, Term::REPO);
 
-    if (Term::stdout_connected()) 
-        std::cout << Term::color_fg(Term::ColorBit4::GREEN) << "Standard output is attached to a terminal." << std::endl << std::endl;
+    if (Term::stdout_connected())
+        Term::print(TERM_MARKUP("{green}Standard output is attached to a terminal.{/}\n\n"));
     else
-        std::cout << Term::color_fg(Term::ColorBit4::RED) << "Standard output is not attached to a terminal." << std::endl << std::endl;
-    std::cout << Term::color_fg(Term::ColorBit4::DEFAULT);
+        Term::print(TERM_MARKUP("{red}Standard output is not attached to a terminal.{/}\n\n"));
 
     int i                = 0;
     const int COLORS_LEN = sizeof(COLORS) / sizeof(Term::rgb);
@@ -69,9 +66,7 @@ int main() {
             /************/
 
             /*-- cat --*/
-            std::cout << Term::style(Term::Style::BOLD)
-                      << CAT[y % COLORS_LEN + (i % 10 < COLORS_LEN ? 0 : COLORS_LEN)]
-                      << Term::style(Term::Style::RESET) << std::endl;
+            Term::print(TERM_MARKUP("{bold}{}{/}\n"), CAT[y % COLORS_LEN + (i % 10 < COLORS_LEN ? 0 : COLORS_LEN)]);
             /***********/
         }
 
@@ -80,6 +75,7 @@ int main() {
             break;
         }
 
+        std::cout << std::flush;
         i++;
         usleep(DELAY); // wait x ms
         Cursor::up(COLORS_LEN); // move up before looping
@@ -0,0 +1,36 @@
+#include <string>
+#include "../include/tty-cpp.hpp"
+
+/**
+ * @brief Lays out a 4x5 grid of titled panels until a key is pressed.
+ *
+ * @details The panels share their edges, Term::draw_box() joins the borders where they meet (├ ┬ ┼ ...). All
+ * of them are drawn into the renderer's buffer and reach the terminal with one write when it is presented.
+ */
+int main() {
+    RawModeGuard raw_mode_guard;
+    Cursor::hide();
+
+    Term::Renderer renderer;
+    Term::CellBuffer& buffer = renderer.buffer();
+    const int rows = 4, columns = 5;
+    const int height = static_cast<int>(buffer.rows() - 1) / rows, width = static_cast<int>(buffer.columns() - 1) / columns;
+    const Term::CellStyle title = Term::CellStyle(Term::ColorBit4::CYAN).with(Term::Style::BOLD);
+
+    for (int panel = 0; panel < rows * columns; panel++) {
+        const int row = panel / columns, column = panel % columns;
+        const std::string name = "panel " + std::to_string(panel + 1);
+        Term::draw_box(buffer, Term::Box{row * height, column * width, height + 1, width + 1, Term::BorderStyle::ROUNDED, Term::CellStyle(), name, title});
+        buffer.print(static_cast<std::size_t>(row * height + 1), static_cast<std::size_t>(column * width + 2), "press any key", Term::CellStyle(Term::ColorBit4::GRAY), static_cast<std::size_t>(width - 3));
+    }
+    // one heavy panel on top, its border joins the light ones it crosses
+    Term::draw_box(buffer, Term::Box{height / 2, width / 2, height + 1, width + 1, Term::BorderStyle::HEAVY, Term::CellStyle(), "focus", title});
+    renderer.present();
+
+    Term::getkey();
+
+    Screen::clear();
+    Cursor::show();
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Generates src/width_table.cpp, the two-level table behind Term::codepoint_width(), from the Unicode data
+# of the running Python (unicodedata): python3 gen_width_table.py > src/width_table.cpp
+import unicodedata
+
+BLOCK = 256
+
+# wide by default even where unassigned, per EastAsianWidth.txt
+WIDE_RANGES = [(0x3400, 0x4DBF), (0x4E00, 0x9FFF), (0xF900, 0xFAFF), (0x20000, 0x2FFFD), (0x30000, 0x3FFFD)]
+# unassigned codepoints reserved for emoji, which will be wide once they're given out
+EMOJI_RANGES = [(0x1F000, 0x1FAFF), (0x1FC00, 0x1FFFD)]
+# joining the codepoint before them without being marks. Term::extends_grapheme() joins every codepoint of
+# width 0 that is not a control, so these and the marks are drawn into the cell before them
+ZERO_RANGES = [(0x1160, 0x11FF), (0xD7B0, 0xD7FF), (0x200B, 0x200D), (0xFE00, 0xFE0F), (0x1F3FB, 0x1F3FF),
+               (0xE0020, 0xE007F), (0xE0100, 0xE01EF)]
+# format characters that are still drawn: the soft hyphen and the prepended concatenation marks
+VISIBLE_FORMAT = {0x00AD, 0x0600, 0x0601, 0x0602, 0x0603, 0x0604, 0x0605, 0x06DD, 0x070F, 0x0890, 0x0891, 0x08E2,
+                  0x110BD, 0x110CD}
+
+
+def width(cp):
+    if any(a <= cp <= b for a, b in ZERO_RANGES):
+        return 0
+    category = unicodedata.category(chr(cp))
+    if category in ('Cc', 'Mn', 'Me') or (category == 'Cf' and cp not in VISIBLE_FORMAT):
+        return 0
+    if any(a <= cp <= b for a, b in WIDE_RANGES):
+        return 2
+    if category == 'Cn':  # unicodedata calls every unassigned codepoint Fullwidth, terminals draw them narrow
+        return 2 if any(a <= cp <= b for a, b in EMOJI_RANGES) else 1
+    return 2 if unicodedata.east_asian_width(chr(cp)) in ('W', 'F') else 1
+
+
+blocks, index = [], []
+for start in range(0, 0x110000, BLOCK):
+    packed = bytearray(BLOCK // 4)
+    for cp in range(start, start + BLOCK):
+        packed[(cp - start) // 4] |= width(cp) << ((cp % 4) * 2)
+    packed = bytes(packed)
+    if packed not in blocks:
+        blocks.append(packed)
+    index.append(blocks.index(packed))
+assert len(blocks) <= 256
+
+
+def rows(values, per_line):
+    for i in range(0, len(values), per_line):
+        yield '    ' + ', '.join('0x%02x' % v for v in values[i:i + per_line]) + ','
+
+
+print('// generated by gen_width_table.py from Unicode %s, do not edit' % unicodedata.unidata_version)
+print('#include "headers/unicode.h"')
+print()
+print('#include <cstdint>')
+print()
+print('// the block of every 256 codepoints')
+print('const std::uint8_t Term::width_blocks[0x110000 / %d] = {' % BLOCK)
+print('\n'.join(rows(index, 16)))
+print('};')
+print()
+print('// %d distinct blocks of 2 bit widths, four codepoints a byte from the low bits' % len(blocks))
+print('const std::uint8_t Term::width_bits[%d * %d] = {' % (len(blocks), BLOCK // 4))
+print('\n'.join(rows(b''.join(blocks), 16)))
+print('};')
@@ -0,0 +1,89 @@
+#include "headers/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+Term::Arena::Arena(std::size_t block_size) : block_size_(block_size) {}
+
+// bytes to skip from p to the next multiple of alignment
+static std::size_t padding(const char* p, std::size_t alignment) {
+    return (alignment - reinterpret_cast<std::uintptr_t>(p) % alignment) % alignment;
+}
+
+void* Term::Arena::allocate(std::size_t size, std::size_t alignment) {
+    // sizes near SIZE_MAX would wrap around below and hand out a block smaller than asked for
+    if (size > SIZE_MAX - alignment)
+        throw std::bad_alloc();
+
+    if (!blocks_.empty()) {
+        Block& block = blocks_.back();
+        const std::size_t start = offset_ + padding(block.data.get() + offset_, alignment);
+        if (start <= block.size && size <= block.size - start) {
+            offset_ = start + size;
+            return block.data.get() + start;
+        }
+        used_ += offset_;
+    }
+
+    const std::size_t block_size = std::max(block_size_, size + alignment);
+    blocks_.push_back(Block{std::make_unique<char[]>(block_size), block_size});
+    char* data = blocks_.back().data.get();
+    offset_ = padding(data, alignment) + size;
+    return data + offset_ - size;
+}
+
+std::string_view Term::Arena::copy(std::string_view text) {
+    char* data = allocate_array<char>(text.size());
+    std::memcpy(data, text.data(), text.size());
+    return std::string_view(data, text.size());
+}
+
+std::string_view Term::Arena::repeat(std::string_view text, std::size_t count) {
+    if (text.empty())
+        return std::string_view();
+    if (count > SIZE_MAX / text.size())
+        throw std::bad_alloc();
+    char* data = allocate_array<char>(text.size() * count);
+    for (std::size_t i = 0; i < count; i++)
+        std::memcpy(data + i * text.size(), text.data(), text.size());
+    return std::string_view(data, text.size() * count);
+}
+
+std::string_view Term::Arena::concat(std::initializer_list<std::string_view> parts) {
+    std::size_t size = 0;
+    for (std::string_view part : parts)
+        size += part.size();
+
+    char* data = allocate_array<char>(size);
+    char* end = data;
+    for (std::string_view part : parts) {
+        std::memcpy(end, part.data(), part.size());
+        end += part.size();
+    }
+    return std::string_view(data, size);
+}
+
+void Term::Arena::reset() {
+    // one block big enough for the whole frame, so the next frame of the same size doesn't allocate
+    if (blocks_.size() > 1) {
+        const std::size_t total = capacity();
+        blocks_.clear();
+        blocks_.push_back(Block{std::make_unique<char[]>(total), total});
+    }
+    offset_ = 0;
+    used_ = 0;
+}
+
+std::size_t Term::Arena::capacity() const {
+    std::size_t total = 0;
+    for (const Block& block : blocks_)
+        total += block.size;
+    return total;
+}
+
+Term::Arena& Term::frame_arena() {
+    static Arena arena;
+    return arena;
+}
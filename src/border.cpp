@@ -0,0 +1,200 @@
+#include "headers/term.h"
+#include "headers/color.h"
+#include "headers/buffer.h"
+#include "headers/border.h"
+
+#include <array>
+#include <cstdint>
+
+/* every box drawing character is described by the weight of its four arms, 2 bits each: up, right, down and
+   left from the lowest bits. joining two characters takes the arms of both and looks the result up again */
+namespace Term {
+namespace Private {
+constexpr int LIGHT_ARM = 1, HEAVY_ARM = 2, DOUBLE_ARM = 3;
+
+constexpr std::uint8_t arms(int up, int right, int down, int left) {
+    return static_cast<std::uint8_t>(up | right << 2 | down << 4 | left << 6);
+}
+
+constexpr std::uint8_t NO_ARMS = 0; // a glyph that is no box drawing character, or no arms
+
+struct Glyph {
+    char32_t glyph;
+    std::uint8_t arms;
+};
+
+// the solid characters of U+2500-U+257F, the dashed ones and diagonals don't join
+constexpr Glyph box_glyphs[] = {
+    {U'─', arms(0, 1, 0, 1)}, {U'━', arms(0, 2, 0, 2)}, {U'│', arms(1, 0, 1, 0)}, {U'┃', arms(2, 0, 2, 0)},
+    {U'┌', arms(0, 1, 1, 0)}, {U'┍', arms(0, 2, 1, 0)}, {U'┎', arms(0, 1, 2, 0)}, {U'┏', arms(0, 2, 2, 0)},
+    {U'┐', arms(0, 0, 1, 1)}, {U'┑', arms(0, 0, 1, 2)}, {U'┒', arms(0, 0, 2, 1)}, {U'┓', arms(0, 0, 2, 2)},
+    {U'└', arms(1, 1, 0, 0)}, {U'┕', arms(1, 2, 0, 0)}, {U'┖', arms(2, 1, 0, 0)}, {U'┗', arms(2, 2, 0, 0)},
+    {U'┘', arms(1, 0, 0, 1)}, {U'┙', arms(1, 0, 0, 2)}, {U'┚', arms(2, 0, 0, 1)}, {U'┛', arms(2, 0, 0, 2)},
+    {U'├', arms(1, 1, 1, 0)}, {U'┝', arms(1, 2, 1, 0)}, {U'┞', arms(2, 1, 1, 0)}, {U'┟', arms(1, 1, 2, 0)},
+    {U'┠', arms(2, 1, 2, 0)}, {U'┡', arms(2, 2, 1, 0)}, {U'┢', arms(1, 2, 2, 0)}, {U'┣', arms(2, 2, 2, 0)},
+    {U'┤', arms(1, 0, 1, 1)}, {U'┥', arms(1, 0, 1, 2)}, {U'┦', arms(2, 0, 1, 1)}, {U'┧', arms(1, 0, 2, 1)},
+    {U'┨', arms(2, 0, 2, 1)}, {U'┩', arms(2, 0, 1, 2)}, {U'┪', arms(1, 0, 2, 2)}, {U'┫', arms(2, 0, 2, 2)},
+    {U'┬', arms(0, 1, 1, 1)}, {U'┭', arms(0, 1, 1, 2)}, {U'┮', arms(0, 2, 1, 1)}, {U'┯', arms(0, 2, 1, 2)},
+    {U'┰', arms(0, 1, 2, 1)}, {U'┱', arms(0, 1, 2, 2)}, {U'┲', arms(0, 2, 2, 1)}, {U'┳', arms(0, 2, 2, 2)},
+    {U'┴', arms(1, 1, 0, 1)}, {U'┵', arms(1, 1, 0, 2)}, {U'┶', arms(1, 2, 0, 1)}, {U'┷', arms(1, 2, 0, 2)},
+    {U'┸', arms(2, 1, 0, 1)}, {U'┹', arms(2, 1, 0, 2)}, {U'┺', arms(2, 2, 0, 1)}, {U'┻', arms(2, 2, 0, 2)},
+    {U'┼', arms(1, 1, 1, 1)}, {U'┽', arms(1, 1, 1, 2)}, {U'┾', arms(1, 2, 1, 1)}, {U'┿', arms(1, 2, 1, 2)},
+    {U'╀', arms(2, 1, 1, 1)}, {U'╁', arms(1, 1, 2, 1)}, {U'╂', arms(2, 1, 2, 1)}, {U'╃', arms(2, 1, 1, 2)},
+    {U'╄', arms(2, 2, 1, 1)}, {U'╅', arms(1, 1, 2, 2)}, {U'╆', arms(1, 2, 2, 1)}, {U'╇', arms(2, 2, 1, 2)},
+    {U'╈', arms(1, 2, 2, 2)}, {U'╉', arms(2, 1, 2, 2)}, {U'╊', arms(2, 2, 2, 1)}, {U'╋', arms(2, 2, 2, 2)},
+    {U'═', arms(0, 3, 0, 3)}, {U'║', arms(3, 0, 3, 0)},
+    {U'╒', arms(0, 3, 1, 0)}, {U'╓', arms(0, 1, 3, 0)}, {U'╔', arms(0, 3, 3, 0)},
+    {U'╕', arms(0, 0, 1, 3)}, {U'╖', arms(0, 0, 3, 1)}, {U'╗', arms(0, 0, 3, 3)},
+    {U'╘', arms(1, 3, 0, 0)}, {U'╙', arms(3, 1, 0, 0)}, {U'╚', arms(3, 3, 0, 0)},
+    {U'╛', arms(1, 0, 0, 3)}, {U'╜', arms(3, 0, 0, 1)}, {U'╝', arms(3, 0, 0, 3)},
+    {U'╞', arms(1, 3, 1, 0)}, {U'╟', arms(3, 1, 3, 0)}, {U'╠', arms(3, 3, 3, 0)},
+    {U'╡', arms(1, 0, 1, 3)}, {U'╢', arms(3, 0, 3, 1)}, {U'╣', arms(3, 0, 3, 3)},
+    {U'╤', arms(0, 3, 1, 3)}, {U'╥', arms(0, 1, 3, 1)}, {U'╦', arms(0, 3, 3, 3)},
+    {U'╧', arms(1, 3, 0, 3)}, {U'╨', arms(3, 1, 0, 1)}, {U'╩', arms(3, 3, 0, 3)},
+    {U'╪', arms(1, 3, 1, 3)}, {U'╫', arms(3, 1, 3, 1)}, {U'╬', arms(3, 3, 3, 3)},
+    {U'╭', arms(0, 1, 1, 0)}, {U'╮', arms(0, 0, 1, 1)}, {U'╯', arms(1, 0, 0, 1)}, {U'╰', arms(1, 1, 0, 0)},
+    {U'╴', arms(0, 0, 0, 1)}, {U'╵', arms(1, 0, 0, 0)}, {U'╶', arms(0, 1, 0, 0)}, {U'╷', arms(0, 0, 1, 0)},
+    {U'╸', arms(0, 0, 0, 2)}, {U'╹', arms(2, 0, 0, 0)}, {U'╺', arms(0, 2, 0, 0)}, {U'╻', arms(0, 0, 2, 0)},
+    {U'╼', arms(0, 2, 0, 1)}, {U'╽', arms(1, 0, 2, 0)}, {U'╾', arms(0, 1, 0, 2)}, {U'╿', arms(2, 0, 1, 0)},
+};
+
+struct Tables {
+    std::array<std::uint8_t, 0x80> arms{};   // by glyph - U+2500
+    std::array<char32_t, 0x100> glyphs{};    // by arms, 0 if there is no such character
+
+    Tables() {
+        for (const Glyph& g : box_glyphs) {
+            arms[g.glyph - 0x2500] = g.arms;
+            if (glyphs[g.arms] == 0) // the arcs come after the square corners
+                glyphs[g.arms] = g.glyph;
+        }
+    }
+};
+
+const Tables& tables() {
+    static const Tables t;
+    return t;
+}
+
+std::uint8_t arms_of(std::uint32_t glyph) {
+    switch (glyph) {
+    case U'-': return arms(0, 1, 0, 1);
+    case U'|': return arms(1, 0, 1, 0);
+    case U'+': return arms(1, 1, 1, 1);
+    default: return glyph >= 0x2500 && glyph < 0x2580 ? tables().arms[glyph - 0x2500] : NO_ARMS;
+    }
+}
+
+char32_t ascii_glyph(std::uint8_t joined) {
+    const bool across = joined & arms(0, 3, 0, 3), along = joined & arms(3, 0, 3, 0);
+    return across && along ? U'+' : across ? U'-' : along ? U'|' : U' ';
+}
+
+char32_t rounded(char32_t glyph) {
+    switch (glyph) {
+    case U'┌': return U'╭';
+    case U'┐': return U'╮';
+    case U'┘': return U'╯';
+    case U'└': return U'╰';
+    default: return glyph;
+    }
+}
+
+int weight(Term::BorderStyle border) {
+    switch (border) {
+    case Term::BorderStyle::HEAVY: return HEAVY_ARM;
+    case Term::BorderStyle::DOUBLE: return DOUBLE_ARM;
+    default: return LIGHT_ARM;
+    }
+}
+
+// put the arms at (row, column), joined with the box drawing character already there. full is the through line
+// to fall back on where no character has the arms, as for the half line ends of a double line
+void join(Term::CellBuffer& buffer, int row, int column, std::uint8_t wanted, std::uint8_t full, Term::BorderStyle border, const Term::CellStyle& style) {
+    if (row < 0 || column < 0 || static_cast<std::size_t>(row) >= buffer.rows() || static_cast<std::size_t>(column) >= buffer.columns())
+        return;
+
+    const Tables& t = tables();
+    const std::uint8_t existing = arms_of(buffer.at(static_cast<std::size_t>(row), static_cast<std::size_t>(column)).glyph);
+    std::uint8_t joined = wanted;
+    for (int shift = 0; shift < 8; shift += 2) { // the new arms win where both have one
+        if (((wanted >> shift) & 3) == 0)
+            joined |= existing & (3 << shift);
+    }
+
+    // not every mix of weights exists, heavy next to double for one, then the new arms go over the old ones
+    char32_t glyph;
+    if (border == Term::BorderStyle::ASCII)
+        glyph = ascii_glyph(joined != 0 ? joined : full);
+    else
+        glyph = t.glyphs[joined] ? t.glyphs[joined] : t.glyphs[wanted] ? t.glyphs[wanted] : t.glyphs[full];
+    if (border == Term::BorderStyle::ROUNDED) // only square corners change, so drawing over a corner keeps it round
+        glyph = rounded(glyph);
+    buffer.set(static_cast<std::size_t>(row), static_cast<std::size_t>(column), Term::Cell{glyph, style});
+}
+
+// the same where the arms always exist, as for the pieces of a box
+void join(Term::CellBuffer& buffer, int row, int column, std::uint8_t wanted, Term::BorderStyle border, const Term::CellStyle& style) {
+    join(buffer, row, column, wanted, wanted, border, style);
+}
+
+std::uint8_t horizontal(int weight, bool left, bool right) { return arms(0, right ? weight : 0, 0, left ? weight : 0); }
+std::uint8_t vertical(int weight, bool up, bool down) { return arms(up ? weight : 0, 0, down ? weight : 0, 0); }
+} // namespace Private
+} // namespace Term
+
+char32_t Term::border_glyph(BorderStyle border, bool up, bool right, bool down, bool left) {
+    const int w = Private::weight(border);
+    const std::uint8_t wanted = Private::arms(up ? w : 0, right ? w : 0, down ? w : 0, left ? w : 0);
+    if (border == BorderStyle::ASCII)
+        return Private::ascii_glyph(wanted);
+    const char32_t glyph = Private::tables().glyphs[wanted];
+    if (glyph == 0)
+        return U' ';
+    return border == BorderStyle::ROUNDED ? Private::rounded(glyph) : glyph;
+}
+
+void Term::draw_hline(CellBuffer& buffer, int row, int column, int width, BorderStyle border, const CellStyle& style) {
+    const int w = Private::weight(border);
+    const std::uint8_t full = Private::horizontal(w, true, true);
+    for (int c = column; c < column + width; c++)
+        Private::join(buffer, row, c, Private::horizontal(w, c > column, c < column + width - 1), full, border, style);
+}
+
+void Term::draw_vline(CellBuffer& buffer, int row, int column, int height, BorderStyle border, const CellStyle& style) {
+    const int w = Private::weight(border);
+    const std::uint8_t full = Private::vertical(w, true, true);
+    for (int r = row; r < row + height; r++)
+        Private::join(buffer, r, column, Private::vertical(w, r > row, r < row + height - 1), full, border, style);
+}
+
+void Term::draw_box(CellBuffer& buffer, const Box& box) {
+    if (box.width < 2 || box.height < 2)
+        return;
+
+    const int w = Private::weight(box.border);
+    const int top = box.row, bottom = box.row + box.height - 1;
+    const int left = box.column, right = box.column + box.width - 1;
+
+    Private::join(buffer, top, left, Private::arms(0, w, w, 0), box.border, box.style);
+    Private::join(buffer, top, right, Private::arms(0, 0, w, w), box.border, box.style);
+    Private::join(buffer, bottom, left, Private::arms(w, w, 0, 0), box.border, box.style);
+    Private::join(buffer, bottom, right, Private::arms(w, 0, 0, w), box.border, box.style);
+    for (int c = left + 1; c < right; c++) {
+        Private::join(buffer, top, c, Private::horizontal(w, true, true), box.border, box.style);
+        Private::join(buffer, bottom, c, Private::horizontal(w, true, true), box.border, box.style);
+    }
+    for (int r = top + 1; r < bottom; r++) {
+        Private::join(buffer, r, left, Private::vertical(w, true, true), box.border, box.style);
+        Private::join(buffer, r, right, Private::vertical(w, true, true), box.border, box.style);
+    }
+
+    // "┌ title ─┐", cut short to keep at least one line cell before the corner
+    const int room = box.width - 5;
+    if (!box.title.empty() && room > 0 && left >= 0 && top >= 0) {
+        const std::size_t row = static_cast<std::size_t>(top), column = static_cast<std::size_t>(left);
+        buffer.set(row, column + 1, Cell{U' ', box.title_style});
+        const std::size_t used = buffer.print(row, column + 2, box.title, box.title_style, static_cast<std::size_t>(room));
+        buffer.set(row, column + 2 + used, Cell{U' ', box.title_style});
+    }
+}
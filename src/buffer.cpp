@@ -0,0 +1,271 @@
+#include "headers/term.h"
+#include "headers/color.h"
+#include "headers/unicode.h"
+#include "headers/buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+std::uint16_t Term::CellStyle::attr_bit(Style style) {
+    switch (style) {
+        case Style::RESET:    return 0;
+        case Style::OVERLINE: return 1 << 9;
+        default:              return static_cast<std::uint16_t>(1 << static_cast<int>(style));
+    }
+}
+
+/*********************** GRAPHEME POOL ***********************/
+std::uint32_t Term::GraphemePool::intern(std::string_view utf8) {
+    char32_t codepoint;
+    const std::size_t used = utf8.empty() ? 0 : utf8_decode(utf8.data(), utf8.size(), codepoint);
+    if (used != 0 && used == utf8.size())
+        return codepoint;
+
+    const auto found = ids_.find(utf8);
+    if (found != ids_.end())
+        return found->second;
+
+    const std::uint32_t id = static_cast<std::uint32_t>(strings_.size()) | INTERNED;
+    strings_.emplace_back(utf8);
+    ids_.emplace(strings_.back(), id);
+    return id;
+}
+
+Term::GraphemePool& Term::graphemes() {
+    static GraphemePool pool;
+    return pool;
+}
+/*************************************************************/
+
+void Term::CellBuffer::resize(std::size_t rows, std::size_t columns) {
+    rows_ = rows;
+    columns_ = columns;
+    glyphs_.assign(rows * columns, U' ');
+    fg_.assign(rows * columns, 0);
+    bg_.assign(rows * columns, 0);
+    attrs_.assign(rows * columns, 0);
+    scrolls_.clear();
+}
+
+int Term::CellBuffer::glyph_width(std::uint32_t glyph) {
+    if (glyph < 0x1100) // nothing wide comes before Hangul Jamo
+        return 1;
+    if (glyph == WIDE_TAIL)
+        return 1;
+
+    char32_t codepoint = glyph;
+    if (glyph & GraphemePool::INTERNED) { // the first codepoint decides, the rest join it
+        const std::string_view text = graphemes().get(glyph);
+        if (utf8_decode(text.data(), text.size(), codepoint) == 0)
+            return 1;
+    }
+    return codepoint_width(codepoint) == 2 ? 2 : 1;
+}
+
+void Term::CellBuffer::unpair(std::size_t i) {
+    const std::size_t column = i % columns_;
+    if (glyphs_[i] == WIDE_TAIL && column > 0)
+        glyphs_[i - 1] = U' ';
+    if (column + 1 < columns_ && glyphs_[i + 1] == WIDE_TAIL)
+        glyphs_[i + 1] = U' ';
+}
+
+void Term::CellBuffer::set(std::size_t row, std::size_t column, const Cell& cell) {
+    if (row >= rows_ || column >= columns_)
+        return;
+
+    const std::size_t i = row * columns_ + column;
+    if (cell.glyph == WIDE_TAIL) { // only restyles the tail of a wide glyph, as when copying cells one by one
+        store(i, glyphs_[i] == WIDE_TAIL ? cell : Cell{U' ', cell.style});
+        return;
+    }
+
+    unpair(i);
+    if (glyph_width(cell.glyph) == 1) {
+        store(i, cell);
+    } else if (column + 1 < columns_) {
+        store(i, cell);
+        unpair(i + 1);
+        store(i + 1, Cell{WIDE_TAIL, cell.style});
+    } else {
+        store(i, Cell{U' ', cell.style}); // half of it would hang off the edge
+    }
+}
+
+std::string Term::CellBuffer::text(std::size_t row) const {
+    std::string text;
+    for (std::size_t i = row * columns_; i < (row + 1) * columns_; i++) {
+        if (glyphs_[i] & GraphemePool::INTERNED)
+            text += graphemes().get(glyphs_[i]);
+        else if (glyphs_[i] != WIDE_TAIL)
+            utf8_append(text, glyphs_[i]);
+    }
+    return text;
+}
+
+std::size_t Term::CellBuffer::print(std::size_t row, std::size_t column, std::string_view text, const CellStyle& style, std::size_t width) {
+    if (row >= rows_ || column >= columns_)
+        return 0;
+
+    const std::size_t start = column;
+    const std::size_t right = columns_ - column > width ? column + width : columns_;
+    std::size_t i = 0;
+    std::size_t cluster = 0; // where the grapheme in the last written cell starts in text
+    std::size_t last = 0;    // the last written cell
+    bool joiner = false;     // the last codepoint was a ZWJ
+    while (i < text.size()) {
+        char32_t codepoint;
+        std::size_t used = utf8_decode(text.data() + i, text.size() - i, codepoint);
+        if (used == 0) { // cut short at the end of the text
+            codepoint = 0xfffd;
+            used = text.size() - i;
+        }
+
+        // the terminal would act on controls instead of drawing them, and with no cell of ours before it a mark
+        // has nothing to join, so both are left out
+        const bool joins = joiner || extends_grapheme(codepoint);
+        if (is_control(codepoint) || (joins && column == start)) {
+            joiner = false;
+            i += used;
+            continue;
+        }
+
+        // combining marks, zero width characters and joined emoji go into the cell before them
+        if (joins) {
+            glyphs_[last] = graphemes().intern(text.substr(cluster, i + used - cluster));
+        } else {
+            const std::size_t cells = codepoint_width(codepoint) == 2 ? 2 : 1;
+            if (column + cells > right)
+                break;
+            cluster = i;
+            last = row * columns_ + column;
+            unpair(last);
+            store(last, Cell{codepoint, style});
+            if (cells == 2) {
+                unpair(last + 1);
+                store(last + 1, Cell{WIDE_TAIL, style});
+            }
+            column += cells;
+        }
+        joiner = codepoint == 0x200d;
+        i += used;
+    }
+    return column - start;
+}
+
+void Term::CellBuffer::fill(std::size_t row, std::size_t column, std::size_t height, std::size_t width, const Cell& cell) {
+    const std::size_t bottom = std::min(rows_, row + height);
+    const std::size_t right = std::min(columns_, column + width);
+    if (column >= right)
+        return;
+
+    if (glyph_width(cell.glyph) == 2) { // pairs of cells, rare enough to go one by one
+        for (std::size_t r = row; r < bottom; r++) {
+            for (std::size_t c = column; c < right; c += 2) {
+                if (c + 1 < right)
+                    set(r, c, cell);
+                else
+                    set(r, c, Cell{U' ', cell.style});
+            }
+        }
+        return;
+    }
+
+    for (std::size_t r = row; r < bottom; r++) {
+        const std::size_t first = r * columns_ + column, last = r * columns_ + right;
+        unpair(first);
+        unpair(last - 1);
+        std::fill(glyphs_.begin() + first, glyphs_.begin() + last, cell.glyph);
+        std::fill(fg_.begin() + first, fg_.begin() + last, cell.style.fg.packed());
+        std::fill(bg_.begin() + first, bg_.begin() + last, cell.style.bg.packed());
+        std::fill(attrs_.begin() + first, attrs_.begin() + last, cell.style.attrs);
+    }
+}
+
+void Term::CellBuffer::restyle(std::size_t row, std::size_t column, std::size_t width, const CellStyle& style) {
+    const std::size_t right = std::min(columns_, column + width);
+    if (row >= rows_ || column >= right)
+        return;
+
+    const std::size_t first = row * columns_ + column, last = row * columns_ + right;
+    std::fill(fg_.begin() + first, fg_.begin() + last, style.fg.packed());
+    std::fill(bg_.begin() + first, bg_.begin() + last, style.bg.packed());
+    std::fill(attrs_.begin() + first, attrs_.begin() + last, style.attrs);
+}
+
+void Term::CellBuffer::clear(const CellStyle& style) {
+    std::fill(glyphs_.begin(), glyphs_.end(), U' ');
+    std::fill(fg_.begin(), fg_.end(), style.fg.packed());
+    std::fill(bg_.begin(), bg_.end(), style.bg.packed());
+    std::fill(attrs_.begin(), attrs_.end(), style.attrs);
+}
+
+template <typename T>
+static void shift_array(std::vector<T>& cells, std::size_t columns, std::size_t top, std::size_t bottom, int lines, T blank) {
+    const std::size_t count = static_cast<std::size_t>(lines > 0 ? lines : -lines);
+    const auto row_begin = [&](std::size_t row) { return cells.begin() + static_cast<std::ptrdiff_t>(row * columns); };
+
+    if (count >= bottom - top) {
+        std::fill(row_begin(top), row_begin(bottom), blank);
+    } else if (lines > 0) {
+        std::copy(row_begin(top + count), row_begin(bottom), row_begin(top));
+        std::fill(row_begin(bottom - count), row_begin(bottom), blank);
+    } else {
+        std::copy_backward(row_begin(top), row_begin(bottom - count), row_begin(bottom));
+        std::fill(row_begin(top), row_begin(top + count), blank);
+    }
+}
+
+void Term::CellBuffer::shift_rows(std::size_t top, std::size_t bottom, int lines) {
+    shift_array<std::uint32_t>(glyphs_, columns_, top, bottom, lines, U' ');
+    shift_array<std::uint32_t>(fg_, columns_, top, bottom, lines, 0);
+    shift_array<std::uint32_t>(bg_, columns_, top, bottom, lines, 0);
+    shift_array<std::uint16_t>(attrs_, columns_, top, bottom, lines, 0);
+}
+
+void Term::CellBuffer::scroll(std::size_t top, std::size_t bottom, int lines) {
+    bottom = std::min(bottom, rows_);
+    if (top >= bottom || lines == 0)
+        return;
+
+    shift_rows(top, bottom, lines);
+    scrolls_.push_back({top, bottom, lines});
+}
+
+bool Term::CellBuffer::same_row(const CellBuffer& other, std::size_t row) const {
+    const std::size_t first = row * columns_;
+    return std::memcmp(&glyphs_[first], &other.glyphs_[first], columns_ * sizeof(std::uint32_t)) == 0
+        && std::memcmp(&fg_[first], &other.fg_[first], columns_ * sizeof(std::uint32_t)) == 0
+        && std::memcmp(&bg_[first], &other.bg_[first], columns_ * sizeof(std::uint32_t)) == 0
+        && std::memcmp(&attrs_[first], &other.attrs_[first], columns_ * sizeof(std::uint16_t)) == 0;
+}
+
+std::uint64_t Term::CellBuffer::row_hash(std::size_t row) const {
+    // FNV-1a, a word at a time, one array after the other
+    std::uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](std::uint64_t word) {
+        hash ^= word;
+        hash *= 1099511628211ull;
+    };
+
+    const std::size_t first = row * columns_, last = first + columns_;
+    for (std::size_t i = first; i < last; i++)
+        mix(glyphs_[i]);
+    for (std::size_t i = first; i < last; i++)
+        mix(fg_[i]);
+    for (std::size_t i = first; i < last; i++)
+        mix(bg_[i]);
+    for (std::size_t i = first; i < last; i++)
+        mix(attrs_[i]);
+    return hash;
+}
+
+void Term::CellBuffer::copy_cells(const CellBuffer& other, std::size_t row, std::size_t column, std::size_t count) {
+    const std::size_t first = row * columns_ + column;
+    std::copy_n(other.glyphs_.begin() + first, count, glyphs_.begin() + first);
+    std::copy_n(other.fg_.begin() + first, count, fg_.begin() + first);
+    std::copy_n(other.bg_.begin() + first, count, bg_.begin() + first);
+    std::copy_n(other.attrs_.begin() + first, count, attrs_.begin() + first);
+}
@@ -0,0 +1,78 @@
+#include "headers/term.h"
+#include "headers/color.h"
+#include "headers/buffer.h"
+#include "headers/canvas.h"
+
+#include <algorithm>
+
+Term::Canvas::Canvas(std::size_t rows, std::size_t columns, Mode mode) : mode_(mode), rows_(rows), columns_(columns) {
+    if (mode_ == Mode::HALF_BLOCK) {
+        pixels_.assign(rows * 2 * columns, NO_PIXEL);
+    } else {
+        dots_.assign(rows * columns, 0);
+        colors_.assign(rows * columns, 0);
+    }
+}
+
+void Term::Canvas::unset(int x, int y) {
+    if (x < 0 || y < 0 || x >= width() || y >= height())
+        return;
+
+    if (mode_ == Mode::HALF_BLOCK)
+        pixels_[static_cast<std::size_t>(y) * columns_ + static_cast<std::size_t>(x)] = NO_PIXEL;
+    else
+        dots_[static_cast<std::size_t>(y / 4) * columns_ + static_cast<std::size_t>(x / 2)] &= ~braille_bits[y % 4][x % 2];
+}
+
+bool Term::Canvas::get(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width() || y >= height())
+        return false;
+
+    if (mode_ == Mode::HALF_BLOCK)
+        return pixels_[static_cast<std::size_t>(y) * columns_ + static_cast<std::size_t>(x)] != NO_PIXEL;
+    return dots_[static_cast<std::size_t>(y / 4) * columns_ + static_cast<std::size_t>(x / 2)] & braille_bits[y % 4][x % 2];
+}
+
+void Term::Canvas::clear() {
+    std::fill(pixels_.begin(), pixels_.end(), NO_PIXEL);
+    std::fill(dots_.begin(), dots_.end(), 0);
+    std::fill(colors_.begin(), colors_.end(), 0);
+}
+
+void Term::Canvas::compose(CellBuffer& buffer, std::size_t row, std::size_t column, const CellStyle& style) const {
+    const std::size_t rows = std::min(rows_, buffer.rows() > row ? buffer.rows() - row : 0);
+    const std::size_t columns = std::min(columns_, buffer.columns() > column ? buffer.columns() - column : 0);
+    const auto color = [&style](std::uint32_t packed) { return packed == 0 ? style.fg : Color::from_packed(packed); };
+
+    for (std::size_t r = 0; r < rows; r++) {
+        for (std::size_t c = 0; c < columns; c++) {
+            Cell cell{U' ', CellStyle(style.fg, style.bg, style.attrs)};
+
+            if (mode_ == Mode::BRAILLE) {
+                const std::size_t i = r * columns_ + c;
+                if (dots_[i] != 0) {
+                    cell.glyph = 0x2800 + dots_[i];
+                    cell.style.fg = color(colors_[i]);
+                }
+            } else {
+                const std::uint32_t top = pixels_[2 * r * columns_ + c];
+                const std::uint32_t bottom = pixels_[(2 * r + 1) * columns_ + c];
+                if (top != NO_PIXEL && bottom != NO_PIXEL && top != bottom) {
+                    cell.glyph = U'▀'; // the top pixel in the foreground, the bottom one as background
+                    cell.style.fg = color(top);
+                    cell.style.bg = color(bottom);
+                } else if (top != NO_PIXEL && bottom != NO_PIXEL) {
+                    cell.glyph = U'█';
+                    cell.style.fg = color(top);
+                } else if (top != NO_PIXEL) {
+                    cell.glyph = U'▀';
+                    cell.style.fg = color(top);
+                } else if (bottom != NO_PIXEL) {
+                    cell.glyph = U'▄';
+                    cell.style.fg = color(bottom);
+                }
+            }
+            buffer.set(row + r, column + c, cell);
+        }
+    }
+}
@@ -1,7 +1,10 @@
 #include "headers/term.h"
 #include "headers/color.h"
+#include "headers/arena.h"
 
 #include <cerrno>
+#include <charconv>
+#include <initializer_list>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <iostream>
@@ -242,3 +245,51 @@ std::string Term::style(Term::Style style) {
     }
 }
 
+
+/* ARENA VERSIONS */
+// CSI prefix values... m, formatted on the stack and copied into the arena
+static std::string_view arena_sgr(Term::Arena& arena, const char* prefix, std::initializer_list<unsigned> values) {
+    char buffer[32] = "\033[";
+    char* end = buffer + 2;
+    for (const char* p = prefix; *p; p++)
+        *end++ = *p;
+    for (unsigned value : values) {
+        if (end[-1] != '[' && end[-1] != ';')
+            *end++ = ';';
+        end = std::to_chars(end, buffer + sizeof(buffer), value).ptr;
+    }
+    *end++ = 'm';
+    return arena.copy(std::string_view(buffer, end - buffer));
+}
+
+std::string_view Term::color_fg(Arena& arena, ColorBit4 color) { return arena_sgr(arena, "", {(std::uint8_t)color + 30u}); }
+std::string_view Term::color_fg(Arena& arena, std::uint8_t color) { return arena_sgr(arena, "38;5;", {color}); }
+std::string_view Term::color_fg(Arena& arena, rgb color) {
+    if (color.empty)
+        return color_fg(arena, ColorBit4::DEFAULT);
+    return arena_sgr(arena, "38;2;", {color.r, color.g, color.b});
+}
+
+std::string_view Term::color_bg(Arena& arena, ColorBit4 color) { return arena_sgr(arena, "", {(std::uint8_t)color + 40u}); }
+std::string_view Term::color_bg(Arena& arena, std::uint8_t color) { return arena_sgr(arena, "48;5;", {color}); }
+std::string_view Term::color_bg(Arena& arena, rgb color) {
+    if (color.empty)
+        return color_bg(arena, ColorBit4::DEFAULT);
+    return arena_sgr(arena, "48;2;", {color.r, color.g, color.b});
+}
+
+std::string_view Term::style(Arena&, Style style) {
+    switch (style) { // constant sequences, nothing to store
+        case Style::RESET:         return "\033[0m";
+        case Style::BOLD:          return "\033[1m";
+        case Style::DIM:           return "\033[2m";
+        case Style::ITALIC:        return "\033[3m";
+        case Style::UNDERLINE:     return "\033[4m";
+        case Style::BLINK:         return "\033[5m";
+        case Style::REVERSE:       return "\033[7m";
+        case Style::CONCEAL:       return "\033[8m";
+        case Style::STRIKETHROUGH: return "\033[9m";
+        case Style::OVERLINE:      return "\033[53m";
+        default:                   return "";
+    }
+}
@@ -1,33 +1,62 @@
 #include "headers/term.h"
+#include "headers/screen.h"
 #include "headers/cursor.h"
 
+#include <algorithm>
+#include <cstdint>
+
+// software tracked cursor position, only valid after an absolute move (or a sync)
+static cursor_pos_t tracked_pos{1, 1};
+static cursor_pos_t saved_pos{1, 1};
+static bool tracked_valid = false;
+static bool saved_valid = false;
+
+// the terminal stops the cursor at the edges of the screen, so the tracked position does too
+static cursor_pos_t on_screen(std::size_t row, std::size_t column) {
+    Screen::Size size{SIZE_MAX, SIZE_MAX}; // no terminal to ask, nothing to stop at
+    try {
+        size = Screen::size();
+    } catch (const Term::Exception&) {
+    }
+    return {std::min(std::max<std::size_t>(row, 1), size.rows), std::min(std::max<std::size_t>(column, 1), size.columns)};
+}
+
 inline void Cursor::set_row(const std::size_t& row) {
-    cursor_pos_t oldpos = Cursor::position(); 
-    Cursor::set(row, oldpos.column);
+    std::cerr << "\033[" << row << 'd' << std::flush;
+    tracked_pos = on_screen(row, tracked_pos.column);
 }
 inline void Cursor::set_column(const std::size_t& column) {
     std::cerr << "\033[" << column << 'G' << std::flush;
+    tracked_pos = on_screen(tracked_pos.row, column);
 }
 inline void Cursor::up(const std::size_t& lines) {
     std::cerr << "\033[" << lines << 'A' << std::flush;
+    tracked_pos.row = tracked_pos.row > lines ? tracked_pos.row - lines : 1;
 }
 inline void Cursor::down(const std::size_t& lines) {
     std::cerr << "\033[" << lines << 'B' << std::flush;
+    tracked_pos = on_screen(tracked_pos.row + lines, tracked_pos.column);
 }
 inline void Cursor::right(const std::size_t& lines) {
     std::cerr << "\033[" << lines << 'C' << std::flush;
+    tracked_pos = on_screen(tracked_pos.row, tracked_pos.column + lines);
 }
 inline void Cursor::left(const std::size_t& lines) {
     std::cerr << "\033[" << lines << 'D' << std::flush;
+    tracked_pos.column = tracked_pos.column > lines ? tracked_pos.column - lines : 1;
 }
 inline void Cursor::next_line(const std::size_t& lines) {
     std::cerr << "\033[" << lines << 'E' << std::flush;
+    tracked_pos = on_screen(tracked_pos.row + lines, 1);
 }
 inline void Cursor::prev_line(const std::size_t& lines) {
     std::cerr << "\033[" << lines << 'F' << std::flush;
+    tracked_pos = {tracked_pos.row > lines ? tracked_pos.row - lines : 1, 1};
 }
 inline void Cursor::home() {
     std::cerr << "\033[H" << std::flush;
+    tracked_pos = {1, 1};
+    tracked_valid = true;
 }
 inline void Cursor::position_report() {
     std::cerr << "\033[6n" << std::flush;
@@ -38,6 +67,16 @@ inline void Cursor::hide() {
 inline void Cursor::show() {
     std::cerr << "\033[?25h" << std::flush;
 }
+inline void Cursor::save() {
+    std::cerr << "\0337" << std::flush;
+    saved_pos = tracked_pos;
+    saved_valid = tracked_valid;
+}
+inline void Cursor::restore() {
+    std::cerr << "\0338" << std::flush;
+    tracked_pos = saved_pos;
+    tracked_valid = saved_valid;
+}
 inline void Cursor::move(const std::size_t& rows, const std::size_t& columns) {
     if      (rows > 0) { Cursor::down(rows); }
     else if (rows < 0) { Cursor::up(rows); }
@@ -47,12 +86,22 @@ inline void Cursor::move(const std::size_t& rows, const std::size_t& columns) {
 }
 inline void Cursor::set(const std::size_t& row, const std::size_t& column) {
     std::cerr << "\033[" << row << ';' << column << 'H' << std::flush;
+    tracked_pos = on_screen(row, column);
+    tracked_valid = true;
 }
 inline void Cursor::set(const cursor_pos_t& pos) {
     Cursor::set(pos.row, pos.column);
 }
 
 inline cursor_pos_t Cursor::position() {
+    if (tracked_valid)
+        return tracked_pos;
+    return Cursor::sync();
+}
+
+inline void Cursor::invalidate() { tracked_valid = false; }
+
+inline cursor_pos_t Cursor::sync() {
     struct termios term;
     cursor_pos_t cursor_pos;
 
@@ -72,7 +121,7 @@ inline cursor_pos_t Cursor::position() {
     std::cerr << "\033[6n" << std::flush;
     char buf[32];
     int i = 0;
-    while (i < 32) {
+    while (i < 31) {
         char c;
         if (read(STDIN_FILENO, &c, 1) != 1) {
             break;
@@ -84,6 +133,9 @@ inline cursor_pos_t Cursor::position() {
     }
     buf[i] = '\0';
 
+    // Restore the original terminal attributes
+    tcsetattr(STDIN_FILENO, TCSANOW, &saved_term);
+
     // Parse the cursor position
     int row, column;
     if (sscanf(buf, "\033[%d;%dR", &row, &column) != 2) {
@@ -93,8 +145,7 @@ inline cursor_pos_t Cursor::position() {
     cursor_pos.row = row;
     cursor_pos.column = column;
 
-    // Restore the original terminal attributes
-    tcsetattr(STDIN_FILENO, TCSANOW, &saved_term);
-
+    tracked_pos = cursor_pos;
+    tracked_valid = true;
     return cursor_pos;
 }
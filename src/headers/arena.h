@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <vector>
+
+namespace Term {
+/* bump allocator for scratch memory that only lives for one frame. allocations are never freed one by one,
+   reset() drops them all at once and keeps the memory, so after a few frames nothing reaches the heap */
+class Arena {
+public:
+    explicit Arena(std::size_t block_size = 16 * 1024);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+    template <typename T>
+    T* allocate_array(std::size_t count) {
+        if (count > SIZE_MAX / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    std::string_view copy(std::string_view text);                       // text stored in the arena
+    std::string_view repeat(std::string_view text, std::size_t count);  // text count times over
+    std::string_view concat(std::initializer_list<std::string_view> parts);
+
+    void reset(); // everything allocated so far is gone, if it took more than one block they merge into one
+    std::size_t used() const { return used_ + offset_; }
+    std::size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks_; // the last one is being filled
+    std::size_t offset_{0};     // into the last block
+    std::size_t used_{0};       // in the blocks before it
+    std::size_t block_size_;
+};
+
+/* memory for standard containers from an arena, i.e. std::vector<int, ArenaAllocator<int>>. deallocate()
+   does nothing, the memory comes back on reset() */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(Arena& arena) : arena_(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+    T* allocate(std::size_t count) { return arena_->allocate_array<T>(count); }
+    void deallocate(T*, std::size_t) {}
+    Arena* arena() const { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena_ == other.arena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena_ != other.arena(); }
+
+private:
+    Arena* arena_;
+};
+
+Arena& frame_arena(); // scratch memory for the current frame, reset by Renderer::present()
+} // namespace Term
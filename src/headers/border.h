@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string_view>
+
+namespace Term {
+enum class BorderStyle { SINGLE, DOUBLE, ROUNDED, HEAVY, ASCII }; // ASCII is + - |
+
+// a panel outline, its title goes into the top border
+struct Box {
+    int row{0};
+    int column{0};
+    int height{0};
+    int width{0};
+    BorderStyle border{BorderStyle::SINGLE};
+    CellStyle style{};
+    std::string_view title{};
+    CellStyle title_style{};
+};
+
+/* draw the outline of box into buffer, clipped to it. where the border lands on box drawing characters already
+   in the buffer the two are joined, so panels sharing an edge get ├ ┬ ┼ and the like instead of overwriting each
+   other. the inside of the box is left alone */
+void draw_box(CellBuffer& buffer, const Box& box);
+void draw_hline(CellBuffer& buffer, int row, int column, int width, BorderStyle border = BorderStyle::SINGLE, const CellStyle& style = CellStyle());
+void draw_vline(CellBuffer& buffer, int row, int column, int height, BorderStyle border = BorderStyle::SINGLE, const CellStyle& style = CellStyle());
+
+// the character with the given arms in border's look (╭ for a rounded corner with right and down arms...), for
+// drawing borders piece by piece without joining. a space if there is no such character
+char32_t border_glyph(BorderStyle border, bool up, bool right, bool down, bool left);
+} // namespace Term
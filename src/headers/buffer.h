@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Term {
+// color of a cell, packed into 32 bits: the kind in the top byte and the color below it
+class Color {
+public:
+    enum class Kind : std::uint8_t { DEFAULT, BIT4, BIT8, BIT24 };
+
+    Color() = default; // the terminal's default color
+    Color(ColorBit4 color) : packed_(color == ColorBit4::DEFAULT ? 0 : pack(Kind::BIT4, static_cast<std::uint8_t>(color))) {}
+    Color(rgb color) : packed_(color.empty ? 0 : pack(Kind::BIT24, (std::uint32_t(color.r) << 16) | (std::uint32_t(color.g) << 8) | color.b)) {}
+    Color(std::uint8_t r, std::uint8_t g, std::uint8_t b) : Color(rgb(r, g, b)) {}
+    static Color index(std::uint8_t color) { return from_packed(pack(Kind::BIT8, color)); } // 8bit color
+    static Color from_packed(std::uint32_t packed) { Color c; c.packed_ = packed; return c; }
+
+    Kind kind() const { return static_cast<Kind>(packed_ >> 24); }
+    std::uint32_t value() const { return packed_ & 0xffffff; } // 4bit/8bit color, or 0xRRGGBB
+    std::uint32_t packed() const { return packed_; }
+
+    bool operator==(const Color& other) const { return packed_ == other.packed_; }
+    bool operator!=(const Color& other) const { return packed_ != other.packed_; }
+
+private:
+    static std::uint32_t pack(Kind kind, std::uint32_t value) { return (static_cast<std::uint32_t>(kind) << 24) | value; }
+    std::uint32_t packed_{0};
+};
+
+// colors and attributes of a cell
+struct CellStyle {
+    Color fg{};
+    Color bg{};
+    std::uint16_t attrs{0}; // one bit per Term::Style, see with()
+
+    CellStyle() = default;
+    CellStyle(Color foreground, Color background = Color(), std::uint16_t attributes = 0) : fg(foreground), bg(background), attrs(attributes) {}
+
+    static std::uint16_t attr_bit(Style style); // RESET has no bit
+    CellStyle with(Style style) const { CellStyle s = *this; s.attrs |= attr_bit(style); return s; }
+    bool has(Style style) const { return attrs & attr_bit(style); }
+
+    bool operator==(const CellStyle& other) const { return fg == other.fg && bg == other.bg && attrs == other.attrs; }
+    bool operator!=(const CellStyle& other) const { return !(*this == other); }
+};
+
+/* graphemes made of several codepoints (a letter and its combining marks, emoji ZWJ sequences...) are
+   interned here so every cell still fits a 4 byte glyph id. the pool only grows and is shared by all
+   buffers, so equal graphemes always get equal ids */
+class GraphemePool {
+public:
+    static constexpr std::uint32_t INTERNED = 0x80000000; // set in the ids of interned graphemes
+
+    std::uint32_t intern(std::string_view utf8); // a single codepoint is its own id and isn't stored
+    std::string_view get(std::uint32_t id) const { return strings_[id & ~INTERNED]; }
+    std::size_t size() const { return strings_.size(); }
+
+private:
+    std::deque<std::string> strings_; // stable addresses, ids_ keys point into them
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+};
+
+GraphemePool& graphemes();
+
+struct Cell {
+    std::uint32_t glyph{U' '}; // a codepoint, or an id from graphemes() if GraphemePool::INTERNED is set
+    CellStyle style{};
+
+    bool operator==(const Cell& other) const { return glyph == other.glyph && style == other.style; }
+    bool operator!=(const Cell& other) const { return !(*this == other); }
+};
+
+/* a grid of cells to draw a frame into (rows and columns start at 0), see Term::Renderer. cells are stored
+   as separate arrays of glyphs, colors and attributes (14 bytes a cell) so rows compare with memcmp.
+   a wide glyph takes two cells, the second one holds WIDE_TAIL. writing over either half blanks the other */
+class CellBuffer {
+public:
+    static constexpr std::uint32_t WIDE_TAIL = 0x110000; // past the last codepoint
+
+    static int glyph_width(std::uint32_t glyph); // columns a glyph takes, 1 or 2
+    // a pending scroll of rows [top, bottom) by lines (> 0 moves content up), replayed by the renderer
+    struct Scroll {
+        std::size_t top;
+        std::size_t bottom;
+        int lines;
+    };
+
+    CellBuffer(std::size_t rows = 0, std::size_t columns = 0) { resize(rows, columns); }
+
+    void resize(std::size_t rows, std::size_t columns); // the contents are cleared
+    std::size_t rows() const { return rows_; }
+    std::size_t columns() const { return columns_; }
+
+    Cell at(std::size_t row, std::size_t column) const {
+        const std::size_t i = row * columns_ + column;
+        return Cell{glyphs_[i], CellStyle(Color::from_packed(fg_[i]), Color::from_packed(bg_[i]), attrs_[i])};
+    }
+    void set(std::size_t row, std::size_t column, const Cell& cell); // ignored outside the buffer
+    std::string text(std::size_t row) const; // the glyphs of a row as UTF-8, without their styles
+
+    // write UTF-8 text on one row, clipped at the right edge or after width columns, returns the columns written
+    std::size_t print(std::size_t row, std::size_t column, std::string_view text, const CellStyle& style = CellStyle(), std::size_t width = SIZE_MAX);
+    void fill(std::size_t row, std::size_t column, std::size_t height, std::size_t width, const Cell& cell); // clipped
+    void restyle(std::size_t row, std::size_t column, std::size_t width, const CellStyle& style); // keeps the glyphs, clipped
+    void clear(const CellStyle& style = CellStyle());
+
+    // move rows [top, bottom) up by lines (down if negative), the uncovered rows are cleared. the renderer
+    // repeats this on the terminal with a scroll region instead of repainting the moved rows
+    void scroll(std::size_t top, std::size_t bottom, int lines);
+    const std::vector<Scroll>& scrolls() const { return scrolls_; }
+    void clear_scrolls() { scrolls_.clear(); }
+
+    // comparisons against a buffer of the same size, for diffing
+    bool same_row(const CellBuffer& other, std::size_t row) const;
+    bool same_cell(const CellBuffer& other, std::size_t row, std::size_t column) const {
+        const std::size_t i = row * columns_ + column;
+        return glyphs_[i] == other.glyphs_[i] && fg_[i] == other.fg_[i] && bg_[i] == other.bg_[i] && attrs_[i] == other.attrs_[i];
+    }
+    std::uint64_t row_hash(std::size_t row) const;
+    void copy_cells(const CellBuffer& other, std::size_t row, std::size_t column, std::size_t count); // from other
+
+private:
+    void store(std::size_t i, const Cell& cell) {
+        glyphs_[i] = cell.glyph;
+        fg_[i] = cell.style.fg.packed();
+        bg_[i] = cell.style.bg.packed();
+        attrs_[i] = cell.style.attrs;
+    }
+    void unpair(std::size_t i); // cell i is about to be written, blank the other half of a wide glyph there
+    void shift_rows(std::size_t top, std::size_t bottom, int lines);
+    friend class Renderer;
+
+    std::size_t rows_{0};
+    std::size_t columns_{0};
+    std::vector<std::uint32_t> glyphs_;
+    std::vector<std::uint32_t> fg_;
+    std::vector<std::uint32_t> bg_;
+    std::vector<std::uint16_t> attrs_;
+    std::vector<Scroll> scrolls_;
+};
+} // namespace Term
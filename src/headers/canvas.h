@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Term {
+/* a pixel grid drawn with sub-cell characters: HALF_BLOCK packs 1x2 pixels per cell (▀ ▄ █, each pixel with
+   its own color), BRAILLE packs 2x4 dots per cell (one color per cell). draw into it, then compose() it into a
+   cell buffer, x grows to the right and y downwards from 0 */
+class Canvas {
+public:
+    enum class Mode { HALF_BLOCK, BRAILLE };
+
+    Canvas(std::size_t rows, std::size_t columns, Mode mode = Mode::BRAILLE); // size in cells
+
+    Mode mode() const { return mode_; }
+    std::size_t rows() const { return rows_; }
+    std::size_t columns() const { return columns_; }
+    int width() const { return static_cast<int>(columns_ * (mode_ == Mode::BRAILLE ? 2 : 1)); }  // in pixels
+    int height() const { return static_cast<int>(rows_ * (mode_ == Mode::BRAILLE ? 4 : 2)); }   // in pixels
+
+    // pixels outside the canvas are ignored, Color() is the foreground of the style given to compose()
+    void set(int x, int y, Color color = Color()) {
+        if (x < 0 || y < 0 || x >= width() || y >= height())
+            return;
+        if (mode_ == Mode::HALF_BLOCK) {
+            pixels_[static_cast<std::size_t>(y) * columns_ + static_cast<std::size_t>(x)] = color.packed();
+        } else {
+            const std::size_t cell = static_cast<std::size_t>(y / 4) * columns_ + static_cast<std::size_t>(x / 2);
+            dots_[cell] |= braille_bits[y % 4][x % 2];
+            colors_[cell] = color.packed(); // a braille cell only has one color, the last one set wins
+        }
+    }
+    void unset(int x, int y);
+    bool get(int x, int y) const;
+    void clear();
+
+    // write the canvas into buffer with its top left cell at (row, column), clipped to the buffer. cells
+    // without pixels are blanks with style's background
+    void compose(CellBuffer& buffer, std::size_t row, std::size_t column, const CellStyle& style = CellStyle()) const;
+
+private:
+    static constexpr std::uint32_t NO_PIXEL = 0xffffffff; // no packed Color looks like this
+    // bit of each dot of a braille cell by [y % 4][x % 2], the dots are numbered 1-8 in that order of bits
+    static constexpr std::uint8_t braille_bits[4][2] = {{0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}};
+
+    Mode mode_;
+    std::size_t rows_;
+    std::size_t columns_;
+    std::vector<std::uint32_t> pixels_; // HALF_BLOCK: a packed color per pixel or NO_PIXEL
+    std::vector<std::uint8_t> dots_;    // BRAILLE: the 8 dot bits of each cell
+    std::vector<std::uint32_t> colors_; // BRAILLE: a packed color per cell
+};
+} // namespace Term
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <exception>
 #include <stdexcept>
 #include <unistd.h>
@@ -108,5 +109,15 @@ std::string color_bg(rgb rgb); // alternative way to set 24 bit color
 
 std::string style(Style style); // set style
 
+// the same sequences written to an arena instead of a new std::string, valid until the arena is reset
+class Arena;
+std::string_view color_fg(Arena& arena, ColorBit4 color);
+std::string_view color_fg(Arena& arena, std::uint8_t color);
+std::string_view color_fg(Arena& arena, rgb color);
+std::string_view color_bg(Arena& arena, ColorBit4 color);
+std::string_view color_bg(Arena& arena, std::uint8_t color);
+std::string_view color_bg(Arena& arena, rgb color);
+std::string_view style(Arena& arena, Style style);
+
 } // namespace Term
 
@@ -19,8 +19,18 @@ inline void position_report();                 // generate a cursor position rep
 inline void hide();                            // hide cursor
 inline void show();                            // show cursor
 
+inline void save();                            // save cursor position (and attributes)
+inline void restore();                         // restore the last saved cursor position
+
 inline void move(const std::size_t&, const std::size_t&); // move cursor by the given row and column
 inline void set(const std::size_t&, const std::size_t&);  // move cursor to given row and column
 inline void set(const cursor_pos_t&);
+
+/* the position is tracked in software from every cursor movement the library emits, kept within the screen
+   like the terminal keeps the cursor. text the library prints (Term::print(), Table::print(), Text) makes it
+   unknown until the next absolute move, text written by the program (std::cout << ...) isn't seen so call
+   invalidate() or sync() after it if the position matters */
 inline cursor_pos_t position();                           // returns the current cursor position (row, column)
+inline cursor_pos_t sync();                               // ask the terminal for the cursor position (blocking round trip)
+inline void invalidate();                                 // forget the tracked position, the next position() call will sync()
 } // namespace Cursor
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "cursor.h"
+
+/* style markup compiled along with the program: "{bold red}error:{/} {} files" turns into the escape sequences
+   and text around one argument slot, so printing it is copying those pieces and formatting the arguments.
+
+   {tags}  styles to set, separated by spaces: bold dim italic underline blink reverse conceal strikethrough
+           overline, or a color (black red green yellow blue magenta cyan white gray default, red_bright and
+           the other brights, 0-255 or #rrggbb), for the background with bg: in front
+   {/}     back to the default style. the text ends with this too if a style is still set
+   {}      an argument: a string, a character, a number or a bool
+   {{ }}   braces
+
+   an unknown tag, a stray brace or a wrong number of arguments doesn't compile. in C++20 the markup is a
+   template argument, Term::print<"{bold}v{/} {}">(version), before that it goes through TERM_MARKUP(), as in
+   Term::print(TERM_MARKUP("{bold}v{/} {}"), version) */
+#define TERM_MARKUP(text) [] { struct Source { static constexpr std::string_view markup() { return text; } }; return Source(); }()
+
+namespace Term {
+namespace Private {
+struct MarkupName {
+    std::string_view name;
+    unsigned code; // SGR parameter
+};
+
+constexpr MarkupName markup_styles[] = {
+    {"bold", 1}, {"dim", 2}, {"italic", 3}, {"underline", 4}, {"blink", 5}, {"reverse", 7}, {"conceal", 8},
+    {"strikethrough", 9}, {"overline", 53}};
+constexpr MarkupName markup_colors[] = { // foreground, backgrounds are 10 up
+    {"black", 30}, {"red", 31}, {"green", 32}, {"yellow", 33}, {"blue", 34}, {"magenta", 35}, {"cyan", 36},
+    {"white", 37}, {"default", 39}, {"gray", 90}, {"red_bright", 91}, {"green_bright", 92},
+    {"yellow_bright", 93}, {"blue_bright", 94}, {"magenta_bright", 95}, {"cyan_bright", 96}, {"white_bright", 97}};
+
+// counts what compile_markup() writes, to size a CompiledMarkup for it
+struct MarkupSize {
+    std::size_t bytes{0};
+    std::size_t slots{0};
+
+    constexpr void put(char) { bytes++; }
+    constexpr void slot() { slots++; }
+};
+
+template <std::size_t Bytes, std::size_t Slots>
+struct CompiledMarkup {
+    char text[Bytes + 1]{};
+    std::size_t slots[Slots + 1]{}; // where in text each argument goes
+    std::size_t size{0};
+    std::size_t slot_count{0};
+
+    constexpr void put(char c) { text[size++] = c; }
+    constexpr void slot() { slots[slot_count++] = size; }
+};
+
+template <typename Out>
+constexpr void put_number(Out& out, unsigned n) {
+    if (n >= 100)
+        out.put(static_cast<char>('0' + n / 100));
+    if (n >= 10)
+        out.put(static_cast<char>('0' + n / 10 % 10));
+    out.put(static_cast<char>('0' + n % 10));
+}
+
+constexpr unsigned hex_digit(char c) {
+    if (c >= '0' && c <= '9')
+        return static_cast<unsigned>(c - '0');
+    if (c >= 'a' && c <= 'f')
+        return static_cast<unsigned>(c - 'a' + 10);
+    if (c >= 'A' && c <= 'F')
+        return static_cast<unsigned>(c - 'A' + 10);
+    throw std::invalid_argument("markup: not a #rrggbb color");
+}
+
+// one word of a tag as SGR parameters, the first one of the tag has no ';' before it
+template <typename Out>
+constexpr void put_tag_word(Out& out, std::string_view word, bool first) {
+    if (!first)
+        out.put(';');
+
+    const bool background = word.substr(0, 3) == "bg:";
+    if (background)
+        word.remove_prefix(3);
+    else
+        for (const MarkupName& style : markup_styles)
+            if (word == style.name)
+                return put_number(out, style.code);
+
+    for (const MarkupName& color : markup_colors)
+        if (word == color.name)
+            return put_number(out, color.code + (background ? 10 : 0));
+
+    if (!word.empty() && word[0] == '#') { // 24bit
+        if (word.size() != 7)
+            throw std::invalid_argument("markup: not a #rrggbb color");
+        put_number(out, background ? 48 : 38);
+        out.put(';');
+        out.put('2');
+        for (std::size_t i = 1; i < 7; i += 2) {
+            out.put(';');
+            put_number(out, hex_digit(word[i]) * 16 + hex_digit(word[i + 1]));
+        }
+        return;
+    }
+
+    unsigned index = 0; // 8bit
+    for (char c : word) {
+        if (c < '0' || c > '9' || (index = index * 10 + static_cast<unsigned>(c - '0')) > 255)
+            throw std::invalid_argument("markup: unknown style");
+    }
+    if (word.empty() || word.size() > 3)
+        throw std::invalid_argument("markup: unknown style");
+    put_number(out, background ? 48 : 38);
+    out.put(';');
+    out.put('5');
+    out.put(';');
+    put_number(out, index);
+}
+
+// run once at compile time with a MarkupSize and then with a CompiledMarkup of that size
+template <typename Out>
+constexpr void compile_markup(std::string_view markup, Out& out) {
+    bool styled = false; // something is set that the end has to reset
+    for (std::size_t i = 0; i < markup.size(); i++) {
+        const char c = markup[i];
+        const bool doubled = i + 1 < markup.size() && markup[i + 1] == c;
+        if (c == '}') {
+            if (!doubled)
+                throw std::invalid_argument("markup: } without a {, write }} for a brace");
+            out.put('}');
+            i++;
+            continue;
+        }
+        if (c != '{') {
+            out.put(c);
+            continue;
+        }
+        if (doubled) {
+            out.put('{');
+            i++;
+            continue;
+        }
+
+        const std::size_t close = markup.find('}', i);
+        if (close == std::string_view::npos)
+            throw std::invalid_argument("markup: { without a }");
+        const std::string_view tag = markup.substr(i + 1, close - i - 1);
+        i = close;
+        if (tag.empty()) {
+            out.slot();
+            continue;
+        }
+
+        out.put('\033');
+        out.put('[');
+        if (tag == "/") {
+            out.put('0');
+            styled = false;
+        } else {
+            bool first = true;
+            for (std::size_t start = 0; start < tag.size();) {
+                if (tag[start] == ' ') {
+                    start++;
+                    continue;
+                }
+                const std::size_t end = std::min(tag.find(' ', start), tag.size());
+                put_tag_word(out, tag.substr(start, end - start), first);
+                first = false;
+                start = end;
+            }
+            if (first)
+                throw std::invalid_argument("markup: empty tag");
+            styled = true;
+        }
+        out.put('m');
+    }
+
+    if (styled) {
+        out.put('\033');
+        out.put('[');
+        out.put('0');
+        out.put('m');
+    }
+}
+
+// the markup of a source type from TERM_MARKUP() or a C++20 template argument, compiled once per source
+template <typename Source>
+struct MarkupOf {
+    static constexpr MarkupSize size = [] {
+        MarkupSize size;
+        compile_markup(Source::markup(), size);
+        return size;
+    }();
+    static constexpr CompiledMarkup<size.bytes, size.slots> value = [] {
+        CompiledMarkup<size.bytes, size.slots> compiled;
+        compile_markup(Source::markup(), compiled);
+        return compiled;
+    }();
+};
+
+template <typename T>
+void append_argument(std::string& out, const T& value) {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        out += std::string_view(value);
+    } else if constexpr (std::is_same_v<T, char>) {
+        out += value;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_integral_v<T>) {
+        char digits[24];
+        out.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        char digits[32];
+        const int length = std::snprintf(digits, sizeof(digits), "%g", static_cast<double>(value));
+        out.append(digits, static_cast<std::size_t>(length));
+    } else {
+        static_assert(sizeof(T) == 0, "markup arguments are strings, characters, numbers and bools");
+    }
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+template <std::size_t N>
+struct FixedString {
+    char chars[N]{};
+
+    constexpr FixedString(const char (&text)[N]) {
+        for (std::size_t i = 0; i < N; i++)
+            chars[i] = text[i];
+    }
+};
+
+template <FixedString Text>
+struct FixedMarkup {
+    static constexpr std::string_view markup() { return std::string_view(Text.chars, sizeof(Text.chars) - 1); }
+};
+#endif
+} // namespace Private
+
+// append the markup to out with the arguments in its {} slots
+template <typename Source, typename... Args>
+void format_to(std::string& out, Source, const Args&... args) {
+    using Markup = Private::MarkupOf<Source>;
+    static_assert(Markup::size.slots == sizeof...(Args), "markup: the number of {} and of arguments differ");
+
+    constexpr const auto& markup = Markup::value;
+    [[maybe_unused]] std::size_t at = 0, slot = 0;
+    ((out.append(markup.text + at, markup.slots[slot] - at), Private::append_argument(out, args), at = markup.slots[slot++]), ...);
+    out.append(markup.text + at, markup.size - at);
+}
+
+template <typename Source, typename... Args>
+std::string format(Source source, const Args&... args) {
+    std::string out;
+    format_to(out, source, args...);
+    return out;
+}
+
+// to std::cout, in one write
+template <typename Source, typename... Args>
+void print(Source source, const Args&... args) {
+    thread_local std::string out; // kept between calls, so printing doesn't allocate once it's big enough
+    out.clear();
+    format_to(out, source, args...);
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+    Cursor::invalidate(); // the text moved it
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+template <Private::FixedString Markup, typename... Args>
+void format_to(std::string& out, const Args&... args) {
+    format_to(out, Private::FixedMarkup<Markup>(), args...);
+}
+
+template <Private::FixedString Markup, typename... Args>
+std::string format(const Args&... args) {
+    return format(Private::FixedMarkup<Markup>(), args...);
+}
+
+template <Private::FixedString Markup, typename... Args>
+void print(const Args&... args) {
+    print(Private::FixedMarkup<Markup>(), args...);
+}
+#endif
+} // namespace Term
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 enum class Key {
     UNKNOWN = -1,
     // ASCII values for control characters
@@ -152,14 +155,155 @@ enum class Key {
     DOWN_ARROW,
     LEFT_ARROW,
     RIGHT_ARROW,
-    CTRL_BASE,
-    // Modifier keys
+    // Modifier keys (only reported on their own by the kitty keyboard protocol)
     ALT,
     SHIFT,
+    CTRL,
+    SUPER,
+    // Navigation keys
+    HOME,
+    END,
+    PAGE_UP,
+    PAGE_DOWN,
+    INSERT,
+    // Function keys
+    F1,
+    F2,
+    F3,
+    F4,
+    F5,
+    F6,
+    F7,
+    F8,
+    F9,
+    F10,
+    F11,
+    F12,
     // Add more keys as needed
 };
 
 namespace Term {
+// modifier bits carried by key and mouse events (same layout as the kitty keyboard protocol)
+enum class Modifier : std::uint8_t {
+    NONE      = 0,
+    SHIFT     = 1,
+    ALT       = 2,
+    CTRL      = 4,
+    SUPER     = 8,   // kitty only
+    HYPER     = 16,  // kitty only
+    META      = 32,  // kitty only
+    CAPS_LOCK = 64,  // kitty only
+    NUM_LOCK  = 128  // kitty only
+};
+
+// progressive enhancement flags for the kitty keyboard protocol, combine with |
+enum KittyFlags : std::uint8_t {
+    KITTY_DISAMBIGUATE      = 1,  // escape codes for ambiguous keys (ESC, ALT+key, CTRL+key...)
+    KITTY_REPORT_EVENTS     = 2,  // report key repeat and release
+    KITTY_REPORT_ALTERNATES = 4,  // report shifted and base layout keys
+    KITTY_REPORT_ALL_KEYS   = 8,  // escape codes for every key, even plain text and modifiers
+    KITTY_REPORT_TEXT       = 16  // report the text a key produces
+};
+
+enum class KeyAction : std::uint8_t {
+    PRESS,
+    REPEAT, // kitty only
+    RELEASE // kitty only
+};
+
+enum class MouseMode : std::uint8_t {
+    CLICK,  // report presses and releases (1000)
+    DRAG,   // also report motion while a button is held (1002)
+    MOTION  // report all motion, even without a button held (1003)
+};
+
+enum class MouseButton : std::uint8_t {
+    LEFT,
+    MIDDLE,
+    RIGHT,
+    NONE, // motion without a button held
+    WHEEL_UP,
+    WHEEL_DOWN,
+    WHEEL_LEFT,
+    WHEEL_RIGHT,
+    BACK,
+    FORWARD
+};
+
+enum class MouseAction : std::uint8_t {
+    PRESS,
+    RELEASE,
+    DRAG, // motion with a button held
+    MOVE  // motion without a button held
+};
+
+struct MouseEvent {
+    std::uint16_t row{0};    // 1-based, same as Cursor::set
+    std::uint16_t column{0}; // 1-based, same as Cursor::set
+    MouseButton button{MouseButton::NONE};
+    MouseAction action{MouseAction::PRESS};
+};
+
+enum class EventType : std::uint8_t {
+    NONE, // nothing was read (EOF or error)
+    KEY,
+    MOUSE,
+    RESIZE // the terminal was resized, Screen::size() already has the new size
+};
+
+// fixed-size input event, decoding one never allocates
+struct Event {
+    EventType type{EventType::NONE};
+    std::uint8_t modifiers{0}; // bitwise OR of Modifier values
+    KeyAction action{KeyAction::PRESS};
+    Key key{Key::UNKNOWN};     // UNKNOWN for text outside of ASCII, see codepoint
+    char32_t codepoint{0};     // unicode codepoint of a typed character, 0 for keys without text (arrows, CTRL+A...)
+    MouseEvent mouse{};
+    std::uint16_t rows{0};     // new terminal size for RESIZE events
+    std::uint16_t columns{0};
+
+    bool has(Modifier mod) const { return modifiers & static_cast<std::uint8_t>(mod); }
+};
+
+/* turns raw terminal input into events, escape sequences split across reads are kept until they complete */
+class InputDecoder {
+public:
+    static constexpr std::size_t MAX_EVENTS   = 64; // decoded events waiting to be taken
+    static constexpr std::size_t MAX_SEQUENCE = 32; // longest escape sequence we wait for
+
+    void feed(const char* data, std::size_t length); // decode raw bytes (the oldest events are dropped if the queue is full)
+    bool next(Event& event);                          // take the oldest decoded event, false if there is none
+    void flush();                                     // resolve an incomplete sequence, i.e. a lone ESC after a timeout
+    bool pending() const { return pending_length_ > 0; }
+
+    // collapse consecutive mouse motion events into the latest one
+    void set_motion_coalescing(bool enabled) { coalesce_motion_ = enabled; }
+    bool motion_coalescing() const { return coalesce_motion_; }
+
+private:
+    std::size_t parse(const char* data, std::size_t length, Event& event) const; // 0 when the sequence is incomplete
+    void drain_pending(bool force);
+    void push(const Event& event);
+
+    Event events_[MAX_EVENTS];
+    std::size_t head_{0};
+    std::size_t count_{0};
+
+    char pending_[MAX_SEQUENCE];
+    std::size_t pending_length_{0};
+
+    bool coalesce_motion_{false};
+};
+
 Key getkey();
+Event getevent(); // blocking, returns an event of type NONE on EOF (also reports terminal resizes)
 int keyhit();
+
+// push kitty keyboard flags, terminals without support ignore this and keep sending legacy sequences
+void enable_kitty_keyboard(std::uint8_t flags = KITTY_DISAMBIGUATE | KITTY_REPORT_EVENTS);
+void disable_kitty_keyboard(); // pop the flags pushed by enable_kitty_keyboard()
+
+void enable_mouse(MouseMode mode = MouseMode::CLICK); // turn on mouse reporting (always in SGR 1006 encoding)
+void disable_mouse();                                 // turn off any mouse reporting
+void set_motion_coalescing(bool enabled);             // coalesce mouse motion read by getevent()
 } // namespace Term
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace Term {
+/* lock-free single-producer/single-consumer ring, i.e. for handing input events from an input thread to a
+   render thread. exactly one thread may call push() and exactly one other thread may call pop() */
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // producer side, returns false if the queue is full
+    bool push(const T& item) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail - cached_head_ == Capacity) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == Capacity)
+                return false;
+        }
+
+        items_[tail & (Capacity - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, returns false if the queue is empty
+    bool pop(T& item) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+                return false;
+        }
+
+        item = items_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // only a snapshot while the other side is running
+    std::size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    // producer and consumer indices live on separate cache lines so the two threads don't fight over them
+    alignas(64) std::atomic<std::size_t> head_{0}; // next slot to read, written by the consumer
+    std::size_t cached_tail_{0};                    // consumer's last view of tail_
+    alignas(64) std::atomic<std::size_t> tail_{0}; // next slot to write, written by the producer
+    std::size_t cached_head_{0};                    // producer's last view of head_
+    alignas(64) T items_[Capacity];
+};
+} // namespace Term
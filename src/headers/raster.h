@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+namespace Term {
+struct Point {
+    int x;
+    int y;
+};
+
+/* drawing into a canvas (in pixels, with Color() being the foreground given to compose()) or straight into a
+   cell buffer (x is the column and y the row). everything is clipped to the target and nothing reaches the
+   terminal until the frame is presented */
+void draw_line(Canvas& canvas, Point from, Point to, Color color = Color());
+void draw_polyline(Canvas& canvas, const std::vector<Point>& points, Color color = Color());
+void draw_rect(Canvas& canvas, Point corner, int width, int height, Color color = Color());
+void fill_rect(Canvas& canvas, Point corner, int width, int height, Color color = Color());
+void draw_circle(Canvas& canvas, Point center, int radius, Color color = Color());
+void fill_circle(Canvas& canvas, Point center, int radius, Color color = Color());
+void fill_polygon(Canvas& canvas, const std::vector<Point>& points, Color color = Color()); // even-odd rule, without the right and bottom edges
+
+void draw_line(CellBuffer& buffer, Point from, Point to, const Cell& cell);
+void draw_polyline(CellBuffer& buffer, const std::vector<Point>& points, const Cell& cell);
+void draw_rect(CellBuffer& buffer, Point corner, int width, int height, const Cell& cell);
+void fill_rect(CellBuffer& buffer, Point corner, int width, int height, const Cell& cell);
+void draw_circle(CellBuffer& buffer, Point center, int radius, const Cell& cell);
+void fill_circle(CellBuffer& buffer, Point center, int radius, const Cell& cell);
+void fill_polygon(CellBuffer& buffer, const std::vector<Point>& points, const Cell& cell);
+} // namespace Term
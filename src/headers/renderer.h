@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Term {
+class WorkerPool;
+
+// append the shortest SGR sequence that takes the terminal from one style to the other, nothing if they're equal
+void append_sgr(std::string& out, const CellStyle& from, const CellStyle& to);
+
+/* the styles used on screen interned to small ids, with the SGR sequence between any two of them
+   built once and then copied. both tables are bounded, trim() empties them between frames when full and a
+   frame with more styles than fit gets FULL for the rest, whose SGR is built each time */
+class StyleTable {
+public:
+    static constexpr std::size_t MAX_STYLES = 4096;
+    static constexpr std::size_t MAX_TRANSITIONS = 16384;
+
+    static constexpr std::uint16_t FULL = 0xffff; // from intern() when the table has no room left this frame
+
+    std::uint16_t intern(const CellStyle& style);
+    const CellStyle& style(std::uint16_t id) const { return styles_[id]; }
+    const std::string& transition(std::uint16_t from, std::uint16_t to); // shortest SGR from one style to the other, not FULL
+    bool trim(); // true if the tables were emptied, which invalidates every id
+    std::size_t size() const { return styles_.size(); }
+
+private:
+    struct StyleHash {
+        std::size_t operator()(const CellStyle& style) const {
+            return (std::size_t(style.fg.packed()) * 0x9e3779b97f4a7c15ull) ^ (std::size_t(style.bg.packed()) << 16) ^ style.attrs;
+        }
+    };
+
+    std::vector<CellStyle> styles_;
+    std::unordered_map<CellStyle, std::uint16_t, StyleHash> ids_;
+    std::unordered_map<std::uint32_t, std::string> transitions_; // by from << 16 | to
+};
+
+/* double buffered drawing: draw a frame into buffer() and present() writes only what changed since the
+   last frame to the terminal, as one write. the buffer keeps its contents between frames */
+class Renderer {
+public:
+    struct Stats {
+        std::size_t bytes{0};         // written by the last present()
+        std::size_t cells{0};         // cells repainted
+        std::size_t scrolled_rows{0}; // rows moved by scrolling (explicit or detected) instead of repainted
+        std::size_t bands{1};         // row bands encoded in parallel
+        bool full_redraw{false};      // cleared and repainted, forced or because it was estimated cheaper
+        // rough byte costs of both strategies the choice was made on (0 when the repaint was forced)
+        std::size_t incremental_estimate{0};
+        std::size_t full_estimate{0};
+    };
+
+    explicit Renderer(Terminal& terminal = Term::terminal()); // sized to the terminal
+    Renderer(Terminal& terminal, std::size_t rows, std::size_t columns);
+    ~Renderer();
+
+    CellBuffer& buffer() { return back_; }
+    std::size_t rows() const { return back_.rows(); }
+    std::size_t columns() const { return back_.columns(); }
+
+    void resize(std::size_t rows, std::size_t columns); // i.e. on a RESIZE event, clears the buffer
+    void invalidate();                                  // the screen was changed behind our back, repaint it all
+    void present(); // also resets frame_arena()
+    // collapse runs of the same cell with REP (CSI n b), for terminals known to have it (xterm and kitty do), off
+    // by default. blank runs always use ECH/EL
+    void use_repeat(bool enabled) { repeat_ = enabled; }
+    // diff and encode large frames in row bands on this many threads (0 for one per core), 1 by default
+    void use_threads(std::size_t threads);
+    const Stats& stats() const { return stats_; }
+
+private:
+    // the output being encoded and what the terminal's cursor and pen will be after it
+    struct Encoder {
+        std::string* out{nullptr};
+        std::string buffer; // bands encode here, the main encoder writes to the terminal's output
+        std::size_t cursor_row{0};
+        std::size_t cursor_column{0};
+        bool cursor_known{false};
+        CellStyle pen{};
+        std::uint16_t pen_id{0};
+        StyleTable styles;
+        std::size_t cells{0};
+        std::size_t first_row{0}; // rows of a band
+        std::size_t last_row{0};
+    };
+
+    void move_to(Encoder& encoder, std::size_t row, std::size_t column);
+    void set_style(Encoder& encoder, const CellStyle& style);
+    std::size_t put(Encoder& encoder, std::size_t row, std::size_t column, const Cell& cell); // returns the cells covered
+    std::size_t put_run(Encoder& encoder, std::size_t row, std::size_t column); // returns the cells written
+    void encode_rows(Encoder& encoder, std::size_t first, std::size_t last);
+    void encode_bands();
+    void apply_scroll(Encoder& encoder, const CellBuffer::Scroll& scroll);
+    void detect_moves(Encoder& encoder); // scroll rows that moved as a block instead of repainting them
+    void estimate_costs();               // fills the estimates in stats_
+    void begin_repaint(Encoder& encoder);
+
+    Terminal& terminal_;
+    CellBuffer front_; // what the terminal shows
+    CellBuffer back_;  // the frame being drawn
+    bool repaint_{true};
+    bool repeat_{false};
+
+    Encoder encoder_;
+    std::vector<Encoder> bands_;
+    std::unique_ptr<WorkerPool> workers_;
+
+    // one hash per row of each buffer, reused between frames
+    std::vector<std::uint64_t> front_hashes_;
+    std::vector<std::uint64_t> back_hashes_;
+    std::uint64_t blank_hash_{0}; // of an empty row
+
+    Stats stats_{};
+};
+} // namespace Term
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
+
 namespace Screen {
 struct Size {
     std::size_t rows;
@@ -15,8 +18,24 @@ inline void clear_line();    // clear the entire line where the cursor is locate
 
 // clear from a specific (Y, X) and a custom (width, height) *idea from Newtrodit*
 inline void clear_partial(const std::size_t&, const std::size_t&, const std::size_t&, const std::size_t&); 
+// append the sequences for the same clear to out instead, to batch it with other output
+void clear_partial(std::string& out, const std::size_t&, const std::size_t&, const std::size_t&, const std::size_t&);
+// clear rectangles with a single DECERA instead of ECH per row (VT420 and up, i.e. xterm), off by default
+void use_rectangular_erase(bool enabled);
+
+// scrolling margins (DECSTBM), rows start at 1 and are inclusive. the terminal homes the cursor when they are set
+inline void set_scroll_region(const std::size_t& top, const std::size_t& bottom);
+inline void reset_scroll_region();               // scroll the whole screen again
+inline void scroll_up(const std::size_t& = 1);   // move the region's content up N lines, blank lines come in at the bottom (SU)
+inline void scroll_down(const std::size_t& = 1); // move the region's content down N lines, blank lines come in at the top (SD)
+// append the sequences to scroll rows top..bottom by N lines (up if > 0, down if < 0), leaving the margins and the cursor as they were
+void scroll_region(std::string& out, const std::size_t& top, const std::size_t& bottom, int lines);
 
 void save();         // save screen state
 void restore();      // restore last saved screen state
-Screen::Size size(); // get terminal screen size
+Screen::Size size(); // get terminal screen size (cached, refreshed after a SIGWINCH)
+
+int resizes();       // SIGWINCHs seen so far, a cached size is stale once this changes
+int resize_fd();     // readable whenever the terminal is resized, for event loops (self-pipe fed by a SIGWINCH handler)
+bool resized();      // drain resize_fd(), true if the terminal was resized since the last call
 } // namespace Screen 
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace Term {
+/* rows of text in aligned columns, drawn into a cell buffer or printed as plain lines. the table only keeps
+   views of the text given to it, which has to stay alive until the table is drawn for the last time. column
+   widths are display widths (see display_width()) and grow as rows are added, nothing is measured twice */
+class Table {
+public:
+    enum class Align { LEFT, CENTER, RIGHT };
+
+    explicit Table(BorderStyle border = BorderStyle::ROUNDED);
+
+    void set_headers(std::initializer_list<std::string_view> headers, Align align = Align::LEFT);
+    void add_row(std::initializer_list<std::string_view> row);
+    void add_row(const std::string_view* cells, std::size_t count); // cells[0] .. cells[count - 1]
+    void clear_rows();
+
+    void set_align(std::size_t column, Align align); // of the column's cells, LEFT by default
+    void set_min_width(std::size_t column, std::size_t width); // the column is never narrower, even without rows
+    void set_borders(bool borders);                  // without them columns are two spaces apart
+    void set_border_style(BorderStyle border) { border_ = border; }
+    void set_header_style(const CellStyle& style) { header_style_ = style; }
+    void set_cell_style(const CellStyle& style) { cell_style_ = style; }
+    void set_line_style(const CellStyle& style) { line_style_ = style; } // of the borders
+
+    bool borders() const { return borders_; }
+    std::size_t columns() const { return widths_.size(); }
+    std::size_t rows() const { return row_start_.size() - 1; } // without the header
+    std::size_t column_width(std::size_t column) const { return widths_[column]; }
+    std::size_t width() const;  // in cells, with the borders
+    std::size_t height() const; // in lines, with the header and the borders
+
+    // draw the table with its top left corner at (row, column), clipped to the buffer
+    void draw(CellBuffer& buffer, std::size_t row, std::size_t column) const;
+    // write the table as lines of text without styles, a chunk of lines at a time
+    void print(std::ostream& out) const;
+
+private:
+    enum class Line { TOP, HEADER, SEPARATOR, ROW, BOTTOM };
+
+    void add_column(std::size_t column); // make room up to column
+    void measure(std::size_t column, std::string_view text, std::uint32_t& width);
+    Line line_kind(std::size_t line, std::size_t& data_row) const;
+    void draw_line(CellBuffer& buffer, std::size_t row, std::size_t column, std::size_t line) const;
+    void draw_rule(CellBuffer& buffer, std::size_t row, std::size_t column, bool up, bool down) const;
+    void draw_cells(CellBuffer& buffer, std::size_t row, std::size_t column, const std::string_view* text, const std::uint32_t* widths,
+                    std::size_t count, const CellStyle& style, const Align* align) const;
+
+    BorderStyle border_;
+    bool borders_{true};
+    CellStyle header_style_;
+    CellStyle cell_style_;
+    CellStyle line_style_;
+
+    std::vector<std::string_view> headers_;
+    std::vector<std::uint32_t> header_widths_;
+    std::vector<Align> header_align_;
+    std::vector<std::string_view> cells_;    // all rows one after the other
+    std::vector<std::uint32_t> cell_widths_; // the display width of each of cells_
+    std::vector<std::size_t> row_start_{0};  // row i is cells_[row_start_[i]] .. cells_[row_start_[i + 1] - 1]
+    std::vector<std::size_t> widths_;        // of each column
+    std::vector<std::size_t> min_widths_;
+    std::vector<Align> align_;
+};
+
+/* a scrolling window over rows that are never all in memory. the provider is asked for the text of the rows on
+   screen only, so drawing and scrolling cost the same for a thousand rows or ten million. column widths are
+   estimated from a sample of the rows and only grow as wider rows scroll into view, so columns don't jump,
+   until set_row_count() starts over from the headers */
+class TableView {
+public:
+    // fill cells[0] .. cells[columns - 1] with the text of row, the views have to stay valid until draw()
+    // returns (Term::frame_arena() is a good place to format into). cells left alone are empty
+    using RowProvider = std::function<void(std::size_t row, std::string_view* cells)>;
+
+    TableView(std::initializer_list<std::string_view> headers, RowProvider provider, BorderStyle border = BorderStyle::ROUNDED);
+
+    void set_row_count(std::size_t rows); // the data changed, the widths are estimated again
+    std::size_t row_count() const { return rows_; }
+    Table& table() { return table_; }     // the table the visible rows are drawn with, for styles and alignment
+    void set_selected_style(const CellStyle& style) { selected_style_ = style; }
+
+    void scroll_to(std::size_t first); // first row on screen
+    void scroll_by(long rows);
+    void select(std::size_t row);      // scrolls just enough to show it
+    void move_selection(long rows);
+    std::size_t first() const { return first_; }
+    std::size_t selected() const { return selected_; }
+    std::size_t page() const { return page_; } // rows shown by the last draw()
+
+    // draw the header and the rows that fit in height lines at (row, column)
+    void draw(CellBuffer& buffer, std::size_t row, std::size_t column, std::size_t height);
+
+private:
+    static constexpr std::size_t SAMPLES = 64; // rows measured for the width estimates
+
+    void estimate_widths();
+    void clamp();
+
+    Table table_;
+    RowProvider provider_;
+    CellStyle selected_style_;
+    std::vector<std::string_view> cells_; // one row for the provider
+    std::size_t rows_{0};
+    std::size_t first_{0};
+    std::size_t selected_{0};
+    std::size_t page_{1};
+    std::size_t drawn_width_{0}; // by the last draw(), what the table no longer covers gets blanked
+};
+} // namespace Term
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <termios.h>
+#include <unistd.h>
+
+namespace Term {
+/* a terminal bound to a pair of file descriptors (stdin/stdout, the slave side of a pty...). it owns its
+   termios state, output buffer and input decoder, so one process can drive any number of terminals,
+   i.e. from a single epoll thread */
+class Terminal {
+public:
+    Terminal(int in_fd = STDIN_FILENO, int out_fd = STDOUT_FILENO);
+    ~Terminal(); // leaves raw mode if it is still enabled, the fds are not closed
+
+    Terminal(const Terminal&) = delete;
+    Terminal& operator=(const Terminal&) = delete;
+
+    int in_fd() const { return in_fd_; }
+    int out_fd() const { return out_fd_; }
+
+    /* TERMIOS */
+    void enable_raw_mode();
+    void disable_raw_mode();
+    bool is_raw_mode() const;
+
+    /* OUTPUT, buffered until flush() */
+    void write(std::string_view data) { output_.append(data.data(), data.size()); }
+    std::string& output() { return output_; }          // the buffer itself, for encoders appending in place
+    std::size_t pending_output() const { return output_.size() - written_; }
+    bool flush(); // false if out_fd would block (non-blocking fds), call again once it is writable
+
+    /* INPUT */
+    bool read_input();               // read what in_fd has into the decoder, false on EOF or error
+    bool next_event(Event& event);   // take the next decoded event
+    InputDecoder& decoder() { return decoder_; }
+
+    /* SIZE */
+    Screen::Size size();             // cached, read again after a SIGWINCH
+    void refresh_size();             // re-read it now, i.e. after resizing a pty whose SIGWINCH goes elsewhere
+
+private:
+    static constexpr std::size_t READ_SIZE = 4096; // bytes read_input() takes from in_fd at once
+
+    int in_fd_;
+    int out_fd_;
+
+    struct termios original_termios_{};
+    bool raw_mode_{false};
+
+    std::string output_;
+    std::size_t written_{0}; // bytes of output_ already written by an interrupted flush()
+
+    InputDecoder decoder_;
+
+    Screen::Size size_{0, 0};
+    bool size_valid_{false};
+    int size_resizes_{0}; // Screen::resizes() when size_ was read
+};
+
+Terminal& terminal(); // the process' own terminal (stdin/stdout), used by the free functions
+} // namespace Term
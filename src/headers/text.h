@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Term {
+// the style of a Text's content up to byte end, from where the span before it ends
+struct StyleSpan {
+    std::uint32_t end;
+    CellStyle style;
+};
+
+/* a piece of a Text (or all of it): a view of the content and of the spans over it, so taking one never parses
+   or allocates. it stays valid until the Text changes */
+class TextView {
+public:
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    TextView() = default;
+    TextView(std::string_view content, const StyleSpan* first, const StyleSpan* last, std::size_t offset)
+        : content_(content), first_(first), last_(last), offset_(offset) {}
+
+    std::string_view content() const { return content_; } // UTF-8 without any escapes
+    std::size_t size() const { return content_.size(); }   // in bytes
+    bool empty() const { return content_.empty(); }
+    std::size_t width() const; // in columns, see display_width()
+
+    TextView substr(std::size_t pos, std::size_t count = npos) const; // in bytes, clamped like std::string_view's
+    // the start of the text that fits in columns, cut between graphemes. wrapping is taking clip() over and
+    // over from what substr(clip().size()) leaves
+    TextView clip(std::size_t columns) const;
+
+    // f(std::string_view text, const CellStyle& style) for each run of one style, in order
+    template <typename F>
+    void for_each_run(F&& f) const {
+        std::size_t at = offset_;
+        const std::size_t stop = offset_ + content_.size();
+        for (const StyleSpan* span = first_; span != last_; span++) {
+            const std::size_t end = std::min<std::size_t>(span->end, stop);
+            f(content_.substr(at - offset_, end - at), span->style);
+            at = end;
+        }
+    }
+
+    // on one row of the buffer like CellBuffer::print(), clipped at its edge or after width columns. returns
+    // the columns written
+    std::size_t draw(CellBuffer& buffer, std::size_t row, std::size_t column, std::size_t width = SIZE_MAX) const;
+    // with SGR sequences between the runs, ending in the default style
+    void print(std::ostream& out) const;
+
+private:
+    std::string_view content_;
+    const StyleSpan* first_{nullptr}; // the spans over content_, their ends count from the start of the Text
+    const StyleSpan* last_{nullptr};
+    std::size_t offset_{0};           // of content_ in the Text
+};
+
+std::ostream& operator<<(std::ostream& out, const TextView& text);
+
+/* styled text: the UTF-8 content in one string and the styles as a run-length list of spans over it, instead of
+   escape sequences mixed into the text. it can be measured, clipped and drawn without parsing anything, and
+   views of parts of it keep their styles. up to 4GiB of content */
+class Text {
+public:
+    Text() = default;
+    Text(std::string_view text, const CellStyle& style = CellStyle()) { append(text, style); }
+
+    // the last span grows when the style is the same as its own
+    Text& append(std::string_view text, const CellStyle& style = CellStyle());
+    Text& append(const TextView& text); // with its styles, from any Text, this one too
+    void reserve(std::size_t bytes, std::size_t spans);
+    void clear();
+
+    std::string_view content() const { return content_; }
+    const std::vector<StyleSpan>& spans() const { return spans_; }
+    std::size_t size() const { return content_.size(); }
+    bool empty() const { return content_.empty(); }
+
+    TextView view() const { return TextView(content_, spans_.data(), spans_.data() + spans_.size(), 0); }
+    operator TextView() const { return view(); }
+
+    std::size_t width() const { return view().width(); }
+    TextView substr(std::size_t pos, std::size_t count = TextView::npos) const { return view().substr(pos, count); }
+    TextView clip(std::size_t columns) const { return view().clip(columns); }
+    std::size_t draw(CellBuffer& buffer, std::size_t row, std::size_t column, std::size_t width = SIZE_MAX) const {
+        return view().draw(buffer, row, column, width);
+    }
+
+private:
+    std::string content_;
+    std::vector<StyleSpan> spans_;
+};
+} // namespace Term
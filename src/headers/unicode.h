@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Term {
+// decode the UTF-8 sequence at data, returns the bytes used or 0 if the sequence is cut short
+// (malformed input decodes to U+FFFD one byte at a time)
+std::size_t utf8_decode(const char* data, std::size_t length, char32_t& codepoint);
+std::string utf8_encode(char32_t codepoint); // get the UTF-8 bytes of a codepoint
+void utf8_append(std::string& out, char32_t codepoint); // the same, appended to out
+
+// true if the codepoint joins the previous one into a single grapheme: everything codepoint_width() gives 0
+// columns that isn't a control (marks of every script, ZWJ, zero width spaces, variation selectors, emoji
+// modifiers and tags). the codepoint after a ZWJ joins as well
+bool extends_grapheme(char32_t codepoint);
+// C0 and C1 controls and DEL, which text drawn into cells leaves out
+inline bool is_control(char32_t codepoint) {
+    return codepoint < 0x20 || (codepoint >= 0x7f && codepoint < 0xa0);
+}
+
+// two-level width table generated by gen_width_table.py: width_blocks picks the block of 256 codepoints, which
+// holds 2 bits per codepoint in width_bits
+extern const std::uint8_t width_blocks[0x110000 / 256];
+extern const std::uint8_t width_bits[];
+
+// columns a codepoint takes on the terminal: 0 for codepoints joining the one before and for controls, 2 for
+// wide ones (East Asian Wide and Fullwidth, which covers emoji), else 1. independent of the locale
+inline int codepoint_width(char32_t codepoint) {
+    if (codepoint < 0x7f) // ASCII
+        return codepoint >= 0x20 ? 1 : 0;
+    if (codepoint > 0x10ffff)
+        return 1;
+    const std::uint8_t bits = width_bits[width_blocks[codepoint >> 8] * 64 + ((codepoint & 0xff) >> 2)];
+    return (bits >> ((codepoint & 3) * 2)) & 3;
+}
+// columns UTF-8 text takes. the same as CellBuffer::print() takes for it: graphemes are joined, controls and
+// marks with nothing before them take nothing
+std::size_t display_width(std::string_view text);
+// the same for text on its way to the terminal: CSI, OSC and other escape sequences in it take no columns
+std::size_t visible_width(std::string_view text);
+} // namespace Term
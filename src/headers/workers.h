@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Term {
+/* a small fixed pool of threads that split the tasks of one job between them, the thread calling run()
+   works on the job as well. meant for short data parallel jobs like encoding the bands of a frame */
+class WorkerPool {
+public:
+    explicit WorkerPool(std::size_t threads); // threads in total, including the caller of run()
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // call task(0) .. task(tasks - 1) spread over the pool, returns once they have all finished
+    void run(std::size_t tasks, const std::function<void(std::size_t)>& task);
+    std::size_t size() const { return threads_.size() + 1; }
+
+private:
+    void work();
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_; // a new job or stop_
+    std::condition_variable idle_; // the last worker left the job
+
+    const std::function<void(std::size_t)>* task_{nullptr};
+    std::size_t tasks_{0};
+    std::atomic<std::size_t> next_{0}; // next task to take
+    std::size_t generation_{0};        // bumped for every job
+    std::size_t active_{0};            // workers inside the current job
+    bool stop_{false};
+};
+} // namespace Term
@@ -1,49 +1,417 @@
 #include "headers/term.h"
 #include "headers/input.h"
+#include "headers/screen.h"
+#include "headers/terminal.h"
+#include "headers/unicode.h"
+#include <cstring>
+#include <cerrno>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 
-Key Term::getkey() {
-    char c;
-
-    if (read(STDIN_FILENO, &c, 1) == 1) {
-        if (c == '\x1b') {
-            char seq[4];
-
-            if (read(STDIN_FILENO, &seq[0], 1) != 1) return Key::ESC;
-            if (read(STDIN_FILENO, &seq[1], 1) != 1) return Key::ESC;
-
-            if (seq[0] == '[') {
-                if (seq[1] >= '0' && seq[1] <= '9') {
-                    if (seq[2] == '~') {
-                        switch (seq[1]) {
-                            case '3': return Key::DEL;
-                        }
-                    }
-                } else {
-                    switch (seq[1]) {
-                        case 'A': return Key::UP_ARROW;
-                        case 'B': return Key::DOWN_ARROW;
-                        case 'C': return Key::RIGHT_ARROW;
-                        case 'D': return Key::LEFT_ARROW;
-                    }
-                }
+// how long a lone ESC waits for the rest of an escape sequence
+static constexpr int ESC_TIMEOUT_MS = 25;
+
+/********************* INPUT DECODER *********************/
+static Term::Event key_event(Key key, std::uint8_t modifiers = 0) {
+    Term::Event event;
+    event.type = Term::EventType::KEY;
+    event.key = key;
+    event.modifiers = modifiers;
+    return event;
+}
+
+static Term::Event text_event(char32_t codepoint, std::uint8_t modifiers = 0) {
+    Term::Event event = key_event(codepoint < 128 ? static_cast<Key>(codepoint) : Key::UNKNOWN, modifiers);
+    event.codepoint = codepoint;
+    return event;
+}
+
+static Key byte_to_key(char c) {
+    if (c == '\r')
+        return Key::ENTER;
+    else if (c >= 1 && c <= 26)
+        return static_cast<Key>(static_cast<int>(Key::CTRL_A) + (c - 1));
+    return static_cast<Key>(c);
+}
+
+// a parsed CSI sequence, only the first subparameter (after ':') of each parameter is kept
+struct CsiSequence {
+    char prefix{0};
+    char final{0};
+    int params[8]{};
+    int subparams[8]{};
+    std::size_t count{0};
+};
+
+// SGR mouse report: CSI < button ; column ; row (M|m)
+static Term::Event sgr_mouse_event(const CsiSequence& csi) {
+    using Term::MouseAction;
+    using Term::MouseButton;
+
+    Term::Event event;
+    if (csi.count != 3)
+        return key_event(Key::UNKNOWN);
+
+    const int code = csi.params[0];
+    event.type = Term::EventType::MOUSE;
+    event.mouse.column = static_cast<std::uint16_t>(csi.params[1]);
+    event.mouse.row = static_cast<std::uint16_t>(csi.params[2]);
+
+    if (code & 4)  event.modifiers |= static_cast<std::uint8_t>(Term::Modifier::SHIFT);
+    if (code & 8)  event.modifiers |= static_cast<std::uint8_t>(Term::Modifier::ALT);
+    if (code & 16) event.modifiers |= static_cast<std::uint8_t>(Term::Modifier::CTRL);
+
+    if (code & 64)
+        event.mouse.button = static_cast<MouseButton>(static_cast<int>(MouseButton::WHEEL_UP) + (code & 3));
+    else if (code & 128)
+        event.mouse.button = (code & 1) ? MouseButton::FORWARD : MouseButton::BACK;
+    else
+        event.mouse.button = static_cast<MouseButton>(code & 3);
+
+    if (csi.final == 'm')
+        event.mouse.action = MouseAction::RELEASE;
+    else if (code & 32)
+        event.mouse.action = event.mouse.button == MouseButton::NONE ? MouseAction::MOVE : MouseAction::DRAG;
+    else
+        event.mouse.action = MouseAction::PRESS;
+
+    return event;
+}
+
+// keys sent as CSI number ~
+static Key tilde_key(int number) {
+    switch (number) {
+        case 1:  return Key::HOME;
+        case 2:  return Key::INSERT;
+        case 3:  return Key::DEL;
+        case 4:  return Key::END;
+        case 5:  return Key::PAGE_UP;
+        case 6:  return Key::PAGE_DOWN;
+        case 7:  return Key::HOME;
+        case 8:  return Key::END;
+        case 11: return Key::F1;
+        case 12: return Key::F2;
+        case 13: return Key::F3;
+        case 14: return Key::F4;
+        case 15: return Key::F5;
+        case 17: return Key::F6;
+        case 18: return Key::F7;
+        case 19: return Key::F8;
+        case 20: return Key::F9;
+        case 21: return Key::F10;
+        case 23: return Key::F11;
+        case 24: return Key::F12;
+        default: return Key::UNKNOWN;
+    }
+}
+
+// kitty key codes that don't produce text
+static Key kitty_functional_key(int code) {
+    switch (code) {
+        case 9:     return Key::HT;
+        case 13:    return Key::ENTER;
+        case 27:    return Key::ESC;
+        case 127:   return Key::DEL; // backspace, the same as the legacy 0x7f byte
+        case 57441: case 57447: return Key::SHIFT;
+        case 57442: case 57448: return Key::CTRL;
+        case 57443: case 57449: return Key::ALT;
+        case 57444: case 57450: return Key::SUPER;
+        default:    return Key::UNKNOWN;
+    }
+}
+
+// kitty key report: CSI code[:alternates] ; modifiers[:action] ; text u
+static Term::Event kitty_key_event(const CsiSequence& csi, std::uint8_t modifiers) {
+    const int code = csi.count >= 1 ? csi.params[0] : 0;
+
+    Key key = kitty_functional_key(code);
+    if (key != Key::UNKNOWN)
+        return key_event(key, modifiers);
+    if (code >= 57344 && code <= 63743) // the rest of kitty's functional keys (F13 up, keypad, media...), no text
+        return key_event(Key::UNKNOWN, modifiers);
+
+    // CTRL+letter keeps the legacy CTRL_A..CTRL_Z keys so existing key checks still work
+    if ((modifiers & static_cast<std::uint8_t>(Term::Modifier::CTRL)) && code >= 'a' && code <= 'z')
+        return key_event(static_cast<Key>(static_cast<int>(Key::CTRL_A) + (code - 'a')), modifiers);
+
+    char32_t text = static_cast<char32_t>(code);
+    if (csi.count >= 3 && csi.params[2] > 0)
+        text = static_cast<char32_t>(csi.params[2]);
+    else if ((modifiers & static_cast<std::uint8_t>(Term::Modifier::SHIFT)) && code >= 'a' && code <= 'z')
+        text = static_cast<char32_t>(code - 'a' + 'A');
+
+    return text_event(text, modifiers);
+}
+
+static Term::Event csi_event(const CsiSequence& csi) {
+    if (csi.prefix == '<' && (csi.final == 'M' || csi.final == 'm'))
+        return sgr_mouse_event(csi);
+    if (csi.prefix != 0)
+        return key_event(Key::UNKNOWN);
+
+    // xterm and kitty both send modifiers as 1 + bits in the second parameter, i.e. CSI 1;5A for CTRL+UP,
+    // kitty adds the key action as its subparameter
+    const std::uint8_t modifiers = csi.count >= 2 && csi.params[1] > 1 ? static_cast<std::uint8_t>(csi.params[1] - 1) : 0;
+    const int action = csi.count >= 2 ? csi.subparams[1] : 0;
+
+    Term::Event event;
+    switch (csi.final) {
+        case 'u': event = kitty_key_event(csi, modifiers); break;
+        case '~': event = key_event(tilde_key(csi.count >= 1 ? csi.params[0] : 0), modifiers); break;
+        case 'A': event = key_event(Key::UP_ARROW, modifiers); break;
+        case 'B': event = key_event(Key::DOWN_ARROW, modifiers); break;
+        case 'C': event = key_event(Key::RIGHT_ARROW, modifiers); break;
+        case 'D': event = key_event(Key::LEFT_ARROW, modifiers); break;
+        case 'H': event = key_event(Key::HOME, modifiers); break;
+        case 'F': event = key_event(Key::END, modifiers); break;
+        case 'P': event = key_event(Key::F1, modifiers); break;
+        case 'Q': event = key_event(Key::F2, modifiers); break;
+        case 'S': event = key_event(Key::F4, modifiers); break;
+        default:  event = key_event(Key::UNKNOWN, modifiers); break; // F3 (CSI R) is left out, it clashes with cursor reports
+    }
+
+    if (action >= 1 && action <= 3)
+        event.action = static_cast<Term::KeyAction>(action - 1);
+    return event;
+}
+
+std::size_t Term::InputDecoder::parse(const char* data, std::size_t length, Event& event) const {
+    const char c = data[0];
+
+    if (static_cast<unsigned char>(c) >= 0x80) {
+        char32_t codepoint;
+        std::size_t used = utf8_decode(data, length, codepoint);
+        if (used > 0)
+            event = text_event(codepoint);
+        return used;
+    }
+
+    if (c != '\x1b') {
+        event = (c >= 32 && c < 127) ? text_event(static_cast<char32_t>(c)) : key_event(byte_to_key(c));
+        return 1;
+    }
+
+    if (length < 2)
+        return 0;
+
+    if (data[1] == 'O') { // SS3, sent for arrows and HOME/END in application cursor mode and for F1-F4
+        if (length < 3)
+            return 0;
+        switch (data[2]) {
+            case 'A': event = key_event(Key::UP_ARROW); break;
+            case 'B': event = key_event(Key::DOWN_ARROW); break;
+            case 'C': event = key_event(Key::RIGHT_ARROW); break;
+            case 'D': event = key_event(Key::LEFT_ARROW); break;
+            case 'H': event = key_event(Key::HOME); break;
+            case 'F': event = key_event(Key::END); break;
+            case 'P': event = key_event(Key::F1); break;
+            case 'Q': event = key_event(Key::F2); break;
+            case 'R': event = key_event(Key::F3); break; // no clash with cursor reports here, unlike CSI R
+            case 'S': event = key_event(Key::F4); break;
+            default:  event = key_event(Key::UNKNOWN); break;
+        }
+        return 3;
+    }
+
+    if (data[1] != '[') {
+        // ESC followed by a printable character is how terminals send ALT+key
+        if (data[1] >= 32 && data[1] < 127) {
+            event = text_event(static_cast<char32_t>(data[1]), static_cast<std::uint8_t>(Modifier::ALT));
+            return 2;
+        }
+        event = key_event(Key::ESC);
+        return 1;
+    }
+
+    // CSI [prefix] params final
+    CsiSequence csi;
+    bool in_param = false;
+    std::size_t field = 0; // 0 for the value itself, 1 for the first subparameter, ignored past that
+
+    for (std::size_t i = 2; i < length && i < MAX_SEQUENCE; i++) {
+        const char b = data[i];
+
+        if ((b >= '0' && b <= '9') || b == ':') {
+            if (!in_param) {
+                if (csi.count < 8) csi.count++;
+                in_param = true;
+                field = 0;
             }
-        } else if (c == '\r') {
-            return Key::ENTER;
-        } else if (c >= 1 && c <= 26) {
-            return static_cast<Key>(static_cast<int>(Key::CTRL_A) + (c - 1));
-        } else {
-            return static_cast<Key>(c);
+            if (b == ':') {
+                field++;
+                continue;
+            }
+            int* target = field == 0 ? &csi.params[csi.count - 1] : field == 1 ? &csi.subparams[csi.count - 1] : nullptr;
+            if (target && *target < 10000000) // keep garbage from overflowing
+                *target = *target * 10 + (b - '0');
+        } else if (b == ';') {
+            if (!in_param && csi.count < 8) csi.count++; // empty parameter
+            in_param = false;
+        } else if (b == '<' || b == '=' || b == '>' || b == '?') {
+            csi.prefix = b;
+        } else if (b >= 0x40 && b <= 0x7e) {
+            csi.final = b;
+            event = csi_event(csi);
+            return i + 1;
+        } else if (b < 0x20 || b > 0x7e) { // not part of a CSI sequence
+            event = key_event(Key::UNKNOWN);
+            return i;
         }
     }
 
-    return Key::UNKNOWN;
+    if (length >= MAX_SEQUENCE) { // runaway sequence, give up on it
+        event = key_event(Key::UNKNOWN);
+        return MAX_SEQUENCE;
+    }
+    return 0;
+}
+
+void Term::InputDecoder::push(const Event& event) {
+    if (coalesce_motion_ && count_ > 0 && event.type == EventType::MOUSE &&
+        (event.mouse.action == MouseAction::MOVE || event.mouse.action == MouseAction::DRAG)) {
+        Event& last = events_[(head_ + count_ - 1) % MAX_EVENTS];
+        if (last.type == EventType::MOUSE && last.mouse.action == event.mouse.action &&
+            last.mouse.button == event.mouse.button && last.modifiers == event.modifiers) {
+            last = event;
+            return;
+        }
+    }
+
+    if (count_ == MAX_EVENTS) { // full, drop the oldest
+        head_ = (head_ + 1) % MAX_EVENTS;
+        count_--;
+    }
+    events_[(head_ + count_) % MAX_EVENTS] = event;
+    count_++;
+}
+
+bool Term::InputDecoder::next(Event& event) {
+    if (count_ == 0)
+        return false;
+    event = events_[head_];
+    head_ = (head_ + 1) % MAX_EVENTS;
+    count_--;
+    return true;
+}
+
+void Term::InputDecoder::drain_pending(bool force) {
+    while (pending_length_ > 0) {
+        Event event;
+        std::size_t used = parse(pending_, pending_length_, event);
+
+        if (used == 0) {
+            if (!force)
+                return;
+            // the sequence never completed, so the leading byte was a key on its own
+            event = key_event(pending_[0] == '\x1b' ? Key::ESC : Key::UNKNOWN);
+            used = 1;
+        }
+
+        push(event);
+        pending_length_ -= used;
+        std::memmove(pending_, pending_ + used, pending_length_);
+    }
+}
+
+void Term::InputDecoder::feed(const char* data, std::size_t length) {
+    std::size_t i = 0;
+
+    // complete a sequence split across reads, parse() never leaves more than MAX_SEQUENCE - 1 bytes pending
+    while (pending_length_ > 0 && i < length) {
+        pending_[pending_length_++] = data[i++];
+        drain_pending(false);
+    }
+
+    while (i < length) {
+        // fast path, plain ASCII text never needs the sequence parser
+        if (data[i] >= 32 && data[i] < 127) {
+            push(text_event(static_cast<char32_t>(data[i++])));
+            continue;
+        }
+
+        Event event;
+        std::size_t used = parse(data + i, length - i, event);
+
+        if (used == 0) {
+            pending_length_ = length - i;
+            std::memcpy(pending_, data + i, pending_length_);
+            break;
+        }
+
+        push(event);
+        i += used;
+    }
+}
+
+void Term::InputDecoder::flush() { drain_pending(true); }
+/*************************************************************/
+
+
+Term::Event Term::getevent() {
+    Terminal& term = Term::terminal();
+    InputDecoder& decoder = term.decoder();
+    Event event;
+
+    while (!decoder.next(event)) {
+        struct pollfd fds[2] = {{term.in_fd(), POLLIN, 0}, {Screen::resize_fd(), POLLIN, 0}};
+        int ready = poll(fds, 2, decoder.pending() ? ESC_TIMEOUT_MS : -1);
+
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready < 0)
+            return Event{};
+        if (ready == 0) { // a lone ESC timed out
+            decoder.flush();
+            continue;
+        }
+
+        if ((fds[1].revents & POLLIN) && Screen::resized()) {
+            Screen::Size size = Screen::size();
+            event.type = EventType::RESIZE;
+            event.rows = static_cast<std::uint16_t>(size.rows);
+            event.columns = static_cast<std::uint16_t>(size.columns);
+            return event;
+        }
+        if (!(fds[0].revents & (POLLIN | POLLHUP | POLLERR)))
+            continue;
+
+        if (!term.read_input())
+            return Event{};
+    }
+
+    return event;
+}
+
+Key Term::getkey() {
+    for (;;) {
+        Event event = Term::getevent();
+
+        if (event.type == EventType::KEY && event.action != KeyAction::RELEASE)
+            return event.key;
+        if (event.type == EventType::NONE)
+            return Key::UNKNOWN;
+    }
 }
 
 int Term::keyhit() {
     int bytesWaiting;
-    ioctl(STDIN_FILENO, FIONREAD, &bytesWaiting);
+    ioctl(Term::terminal().in_fd(), FIONREAD, &bytesWaiting);
 
     return bytesWaiting;
 }
+
+void Term::enable_kitty_keyboard(std::uint8_t flags) { std::cerr << "\033[>" << static_cast<int>(flags) << 'u' << std::flush; }
+void Term::disable_kitty_keyboard()                   { std::cerr << "\033[<u" << std::flush; }
+
+void Term::enable_mouse(MouseMode mode) {
+    switch (mode) {
+        case MouseMode::CLICK:  std::cerr << "\033[?1000h"; break;
+        case MouseMode::DRAG:   std::cerr << "\033[?1002h"; break;
+        case MouseMode::MOTION: std::cerr << "\033[?1003h"; break;
+    }
+    std::cerr << "\033[?1006h" << std::flush;
+}
+
+void Term::disable_mouse() { std::cerr << "\033[?1003l\033[?1002l\033[?1000l\033[?1006l" << std::flush; }
+void Term::set_motion_coalescing(bool enabled) { Term::terminal().decoder().set_motion_coalescing(enabled); }
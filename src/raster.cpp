@@ -0,0 +1,321 @@
+#include "headers/term.h"
+#include "headers/color.h"
+#include "headers/buffer.h"
+#include "headers/canvas.h"
+#include "headers/raster.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+/* the algorithms below are written once against a target with width(), height(), plot(x, y) and
+   span(y, x0, x1). they clip before calling plot() or span(), which then don't need to check */
+namespace Term {
+namespace Private {
+struct CanvasTarget {
+    Term::Canvas& canvas;
+    Term::Color color;
+
+    int width() const { return canvas.width(); }
+    int height() const { return canvas.height(); }
+    void plot(int x, int y) { canvas.set(x, y, color); }
+    void span(int y, int x0, int x1) {
+        for (int x = x0; x <= x1; x++)
+            canvas.set(x, y, color);
+    }
+};
+
+struct BufferTarget {
+    Term::CellBuffer& buffer;
+    const Term::Cell& cell;
+
+    int width() const { return static_cast<int>(buffer.columns()); }
+    int height() const { return static_cast<int>(buffer.rows()); }
+    void plot(int x, int y) { buffer.set(static_cast<std::size_t>(y), static_cast<std::size_t>(x), cell); }
+    void span(int y, int x0, int x1) { buffer.fill(static_cast<std::size_t>(y), static_cast<std::size_t>(x0), 1, static_cast<std::size_t>(x1 - x0 + 1), cell); }
+};
+
+// the sides of the target a point is outside of, as bits
+constexpr int OUTSIDE_LEFT = 1, OUTSIDE_RIGHT = 2, OUTSIDE_ABOVE = 4, OUTSIDE_BELOW = 8;
+
+int outcode(std::int64_t x, std::int64_t y, int width, int height) {
+    return (x < 0 ? OUTSIDE_LEFT : x >= width ? OUTSIDE_RIGHT : 0) | (y < 0 ? OUTSIDE_ABOVE : y >= height ? OUTSIDE_BELOW : 0);
+}
+
+// Cohen-Sutherland, false if no part of the line is inside. the clipped ends are rounded to whole pixels
+bool clip_line(std::int64_t& x0, std::int64_t& y0, std::int64_t& x1, std::int64_t& y1, int width, int height) {
+    int code0 = outcode(x0, y0, width, height), code1 = outcode(x1, y1, width, height);
+    while (code0 | code1) {
+        if (code0 & code1)
+            return false;
+
+        const int code = code0 ? code0 : code1;
+        std::int64_t x, y;
+        const std::int64_t dx = x1 - x0, dy = y1 - y0;
+        if (code & OUTSIDE_ABOVE) {
+            y = 0;
+            x = x0 + dx * (y - y0) / dy;
+        } else if (code & OUTSIDE_BELOW) {
+            y = height - 1;
+            x = x0 + dx * (y - y0) / dy;
+        } else if (code & OUTSIDE_LEFT) {
+            x = 0;
+            y = y0 + dy * (x - x0) / dx;
+        } else {
+            x = width - 1;
+            y = y0 + dy * (x - x0) / dx;
+        }
+
+        if (code == code0) {
+            x0 = x;
+            y0 = y;
+            code0 = outcode(x0, y0, width, height);
+        } else {
+            x1 = x;
+            y1 = y;
+            code1 = outcode(x1, y1, width, height);
+        }
+    }
+    return true;
+}
+
+template <typename Target>
+void line(Target& target, Term::Point from, Term::Point to) {
+    std::int64_t x0 = from.x, y0 = from.y, x1 = to.x, y1 = to.y;
+    if (!clip_line(x0, y0, x1, y1, target.width(), target.height()))
+        return;
+
+    // Bresenham for all octants
+    int x = static_cast<int>(x0), y = static_cast<int>(y0);
+    const int end_x = static_cast<int>(x1), end_y = static_cast<int>(y1);
+    const int dx = std::abs(end_x - x), dy = -std::abs(end_y - y);
+    const int step_x = x < end_x ? 1 : -1, step_y = y < end_y ? 1 : -1;
+    int error = dx + dy;
+    for (;;) {
+        target.plot(x, y);
+        if (x == end_x && y == end_y)
+            break;
+        const int error2 = 2 * error;
+        if (error2 >= dy) {
+            error += dy;
+            x += step_x;
+        }
+        if (error2 <= dx) {
+            error += dx;
+            y += step_y;
+        }
+    }
+}
+
+template <typename Target>
+void clipped_span(Target& target, int y, int x0, int x1) {
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, target.width() - 1);
+    if (y >= 0 && y < target.height() && x0 <= x1)
+        target.span(y, x0, x1);
+}
+
+template <typename Target>
+void clipped_plot(Target& target, int x, int y) {
+    if (x >= 0 && y >= 0 && x < target.width() && y < target.height())
+        target.plot(x, y);
+}
+
+template <typename Target>
+void polyline(Target& target, const std::vector<Term::Point>& points) {
+    if (points.size() == 1)
+        clipped_plot(target, points[0].x, points[0].y);
+    for (std::size_t i = 1; i < points.size(); i++)
+        line(target, points[i - 1], points[i]);
+}
+
+template <typename Target>
+void rect(Target& target, Term::Point corner, int width, int height) {
+    if (width <= 0 || height <= 0)
+        return;
+
+    const int right = corner.x + width - 1, bottom = corner.y + height - 1;
+    clipped_span(target, corner.y, corner.x, right);
+    if (height > 1)
+        clipped_span(target, bottom, corner.x, right);
+    for (int y = std::max(corner.y + 1, 0); y < std::min(bottom, target.height()); y++) {
+        clipped_plot(target, corner.x, y);
+        if (width > 1)
+            clipped_plot(target, right, y);
+    }
+}
+
+template <typename Target>
+void filled_rect(Target& target, Term::Point corner, int width, int height) {
+    if (width <= 0 || height <= 0)
+        return;
+    for (int y = std::max(corner.y, 0); y < std::min(corner.y + height, target.height()); y++)
+        clipped_span(target, y, corner.x, corner.x + width - 1);
+}
+
+// midpoint circle, calls octants(x, y) for every point of the first octant with x >= y
+template <typename Function>
+void midpoint_circle(int radius, Function octants) {
+    int x = radius, y = 0, decision = 1 - radius;
+    while (x >= y) {
+        octants(x, y);
+        y++;
+        if (decision < 0) {
+            decision += 2 * y + 1;
+        } else {
+            x--;
+            decision += 2 * (y - x) + 1;
+        }
+    }
+}
+
+template <typename Target>
+void circle(Target& target, Term::Point center, int radius) {
+    if (radius < 0)
+        return;
+    const int cx = center.x, cy = center.y;
+    midpoint_circle(radius, [&](int x, int y) {
+        clipped_plot(target, cx + x, cy + y);
+        clipped_plot(target, cx - x, cy + y);
+        clipped_plot(target, cx + x, cy - y);
+        clipped_plot(target, cx - x, cy - y);
+        clipped_plot(target, cx + y, cy + x);
+        clipped_plot(target, cx - y, cy + x);
+        clipped_plot(target, cx + y, cy - x);
+        clipped_plot(target, cx - y, cy - x);
+    });
+}
+
+template <typename Target>
+void filled_circle(Target& target, Term::Point center, int radius) {
+    if (radius < 0)
+        return;
+    const int cx = center.x, cy = center.y;
+    midpoint_circle(radius, [&](int x, int y) {
+        clipped_span(target, cy + y, cx - x, cx + x);
+        clipped_span(target, cy - y, cx - x, cx + x);
+        clipped_span(target, cy + x, cx - y, cx + y);
+        clipped_span(target, cy - x, cx - y, cx + y);
+    });
+}
+
+// smallest integer not below numerator / denominator
+std::int64_t ceil_div(std::int64_t numerator, std::int64_t denominator) {
+    if (denominator < 0) {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+    return numerator >= 0 ? (numerator + denominator - 1) / denominator : -(-numerator / denominator);
+}
+
+// scanline fill, sampling at the pixel positions. an edge covers the rows from its top up to but without its
+// bottom and a span the pixels from its left crossing up to but without its right one, so polygons sharing an
+// edge don't overlap
+template <typename Target>
+void polygon(Target& target, const std::vector<Term::Point>& points) {
+    if (points.size() < 3)
+        return;
+
+    int top = points[0].y, bottom = points[0].y;
+    for (const Term::Point& point : points) {
+        top = std::min(top, point.y);
+        bottom = std::max(bottom, point.y);
+    }
+    top = std::max(top, 0);
+    bottom = std::min(bottom, target.height() - 1);
+
+    // a scanline crosses every edge at most once. the crossings have their own buffer, kept between calls so
+    // filling stops allocating once it has grown, instead of frame_arena() which only Renderer::present() resets
+    thread_local std::vector<int> crossings;
+    if (crossings.size() < points.size())
+        crossings.resize(points.size());
+    for (int y = top; y <= bottom; y++) {
+        std::size_t count = 0;
+        for (std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+            const Term::Point& a = points[j];
+            const Term::Point& b = points[i];
+            if ((a.y <= y) == (b.y <= y))
+                continue;
+            const std::int64_t x = a.x + ceil_div(std::int64_t(y - a.y) * (b.x - a.x), b.y - a.y);
+            crossings[count++] = static_cast<int>(std::min<std::int64_t>(std::max<std::int64_t>(x, -1), target.width()));
+        }
+
+        std::sort(crossings.begin(), crossings.begin() + static_cast<std::ptrdiff_t>(count));
+        for (std::size_t i = 0; i + 1 < count; i += 2)
+            clipped_span(target, y, crossings[i], crossings[i + 1] - 1);
+    }
+}
+} // namespace Private
+} // namespace Term
+
+void Term::draw_line(Canvas& canvas, Point from, Point to, Color color) {
+    Private::CanvasTarget target{canvas, color};
+    Private::line(target, from, to);
+}
+
+void Term::draw_polyline(Canvas& canvas, const std::vector<Point>& points, Color color) {
+    Private::CanvasTarget target{canvas, color};
+    Private::polyline(target, points);
+}
+
+void Term::draw_rect(Canvas& canvas, Point corner, int width, int height, Color color) {
+    Private::CanvasTarget target{canvas, color};
+    Private::rect(target, corner, width, height);
+}
+
+void Term::fill_rect(Canvas& canvas, Point corner, int width, int height, Color color) {
+    Private::CanvasTarget target{canvas, color};
+    Private::filled_rect(target, corner, width, height);
+}
+
+void Term::draw_circle(Canvas& canvas, Point center, int radius, Color color) {
+    Private::CanvasTarget target{canvas, color};
+    Private::circle(target, center, radius);
+}
+
+void Term::fill_circle(Canvas& canvas, Point center, int radius, Color color) {
+    Private::CanvasTarget target{canvas, color};
+    Private::filled_circle(target, center, radius);
+}
+
+void Term::fill_polygon(Canvas& canvas, const std::vector<Point>& points, Color color) {
+    Private::CanvasTarget target{canvas, color};
+    Private::polygon(target, points);
+}
+
+void Term::draw_line(CellBuffer& buffer, Point from, Point to, const Cell& cell) {
+    Private::BufferTarget target{buffer, cell};
+    Private::line(target, from, to);
+}
+
+void Term::draw_polyline(CellBuffer& buffer, const std::vector<Point>& points, const Cell& cell) {
+    Private::BufferTarget target{buffer, cell};
+    Private::polyline(target, points);
+}
+
+void Term::draw_rect(CellBuffer& buffer, Point corner, int width, int height, const Cell& cell) {
+    Private::BufferTarget target{buffer, cell};
+    Private::rect(target, corner, width, height);
+}
+
+void Term::fill_rect(CellBuffer& buffer, Point corner, int width, int height, const Cell& cell) {
+    Private::BufferTarget target{buffer, cell};
+    Private::filled_rect(target, corner, width, height);
+}
+
+void Term::draw_circle(CellBuffer& buffer, Point center, int radius, const Cell& cell) {
+    Private::BufferTarget target{buffer, cell};
+    Private::circle(target, center, radius);
+}
+
+void Term::fill_circle(CellBuffer& buffer, Point center, int radius, const Cell& cell) {
+    Private::BufferTarget target{buffer, cell};
+    Private::filled_circle(target, center, radius);
+}
+
+void Term::fill_polygon(CellBuffer& buffer, const std::vector<Point>& points, const Cell& cell) {
+    Private::BufferTarget target{buffer, cell};
+    Private::polygon(target, points);
+}
@@ -0,0 +1,548 @@
+#include "headers/term.h"
+#include "headers/color.h"
+#include "headers/cursor.h"
+#include "headers/input.h"
+#include "headers/screen.h"
+#include "headers/terminal.h"
+#include "headers/unicode.h"
+#include "headers/buffer.h"
+#include "headers/arena.h"
+#include "headers/workers.h"
+#include "headers/renderer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+// std::to_string allocates, frames are encoded straight into the terminal's output buffer
+static void append_number(std::string& out, std::size_t n) {
+    char digits[20];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n != 0);
+    while (length > 0)
+        out += digits[--length];
+}
+
+static std::size_t count_digits(std::size_t n) {
+    std::size_t digits = 1;
+    while (n >= 10) {
+        n /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+// bytes put() writes for a glyph
+static std::size_t encoded_size(std::uint32_t glyph) {
+    if (glyph & Term::GraphemePool::INTERNED)
+        return Term::graphemes().get(glyph).size();
+    return glyph < 0x80 ? 1 : glyph < 0x800 ? 2 : glyph < 0x10000 ? 3 : 4;
+}
+
+static void append_color(std::string& out, const Term::Color& color, bool background) {
+    switch (color.kind()) {
+        case Term::Color::Kind::DEFAULT:
+            out += background ? ";49" : ";39";
+            break;
+        case Term::Color::Kind::BIT4:
+            out += ';';
+            append_number(out, color.value() + (background ? 40 : 30));
+            break;
+        case Term::Color::Kind::BIT8:
+            out += background ? ";48;5;" : ";38;5;";
+            append_number(out, color.value());
+            break;
+        case Term::Color::Kind::BIT24:
+            out += background ? ";48;2;" : ";38;2;";
+            append_number(out, color.value() >> 16);
+            out += ';';
+            append_number(out, (color.value() >> 8) & 0xff);
+            out += ';';
+            append_number(out, color.value() & 0xff);
+            break;
+    }
+}
+
+void Term::append_sgr(std::string& out, const CellStyle& from, const CellStyle& to) {
+    if (from == to)
+        return;
+
+    static const unsigned char attr_codes[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 53}; // by attribute bit
+    const std::size_t start = out.size();
+    out += "\033[";
+
+    // attributes can't be turned off one by one portably, dropping any of them means starting over
+    const bool reset = (from.attrs & ~to.attrs) != 0 || to == CellStyle();
+    const std::uint16_t added = reset ? to.attrs : to.attrs & ~from.attrs;
+    if (reset)
+        out += '0';
+    for (unsigned bit = 1; bit < sizeof(attr_codes); bit++) {
+        if (added & (1u << bit)) {
+            out += ';';
+            append_number(out, attr_codes[bit]);
+        }
+    }
+    if (reset ? to.fg != Color() : to.fg != from.fg)
+        append_color(out, to.fg, false);
+    if (reset ? to.bg != Color() : to.bg != from.bg)
+        append_color(out, to.bg, true);
+    if (out[start + 2] == ';')
+        out.erase(start + 2, 1); // nothing was reset, the first parameter has no separator before it
+    out += 'm';
+}
+
+/*********************** STYLE TABLE ***********************/
+std::uint16_t Term::StyleTable::intern(const CellStyle& style) {
+    const auto found = ids_.find(style);
+    if (found != ids_.end())
+        return found->second;
+
+    if (styles_.size() >= MAX_STYLES) // more styles in one frame than fit, trim() makes room for the next one
+        return FULL;
+
+    const std::uint16_t id = static_cast<std::uint16_t>(styles_.size());
+    styles_.push_back(style);
+    ids_.emplace(style, id);
+    return id;
+}
+
+const std::string& Term::StyleTable::transition(std::uint16_t from, std::uint16_t to) {
+    const std::uint32_t key = (std::uint32_t(from) << 16) | to;
+    const auto found = transitions_.find(key);
+    if (found != transitions_.end())
+        return found->second;
+
+    if (transitions_.size() >= MAX_TRANSITIONS)
+        transitions_.clear();
+
+    std::string sgr;
+    append_sgr(sgr, styles_[from], styles_[to]);
+    return transitions_.emplace(key, std::move(sgr)).first->second;
+}
+
+bool Term::StyleTable::trim() {
+    if (styles_.size() < MAX_STYLES)
+        return false;
+    styles_.clear();
+    ids_.clear();
+    transitions_.clear();
+    return true;
+}
+/*************************************************************/
+
+Term::Renderer::Renderer(Terminal& terminal) : terminal_(terminal) {
+    const Screen::Size size = terminal_.size();
+    resize(size.rows, size.columns);
+}
+
+Term::Renderer::Renderer(Terminal& terminal, std::size_t rows, std::size_t columns) : terminal_(terminal) {
+    resize(rows, columns);
+}
+
+Term::Renderer::~Renderer() = default;
+
+void Term::Renderer::resize(std::size_t rows, std::size_t columns) {
+    back_.resize(rows, columns);
+    front_.resize(rows, columns);
+    blank_hash_ = CellBuffer(1, columns).row_hash(0);
+    repaint_ = true;
+}
+
+void Term::Renderer::invalidate() {
+    repaint_ = true;
+}
+
+void Term::Renderer::use_threads(std::size_t threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    if (threads == 1)
+        workers_.reset();
+    else if (!workers_ || workers_->size() != threads)
+        workers_ = std::make_unique<WorkerPool>(threads);
+}
+
+void Term::Renderer::move_to(Encoder& encoder, std::size_t row, std::size_t column) {
+    std::string& out = *encoder.out;
+    if (encoder.cursor_known && encoder.cursor_row == row && encoder.cursor_column == column)
+        return;
+
+    if (encoder.cursor_known && encoder.cursor_row == row && encoder.cursor_column < column) {
+        out += "\033["; // CUF is shorter than CUP within a row
+        append_number(out, column - encoder.cursor_column);
+        out += 'C';
+    } else {
+        out += "\033[";
+        append_number(out, row + 1);
+        out += ';';
+        append_number(out, column + 1);
+        out += 'H';
+    }
+    encoder.cursor_row = row;
+    encoder.cursor_column = column;
+    encoder.cursor_known = true;
+}
+
+void Term::Renderer::set_style(Encoder& encoder, const CellStyle& style) {
+    if (style == encoder.pen)
+        return;
+
+    const std::uint16_t id = encoder.styles.intern(style);
+    if (id == StyleTable::FULL || encoder.pen_id == StyleTable::FULL)
+        append_sgr(*encoder.out, encoder.pen, style); // built every time until the table has room again
+    else
+        *encoder.out += encoder.styles.transition(encoder.pen_id, id);
+    encoder.pen = style;
+    encoder.pen_id = id;
+}
+
+std::size_t Term::Renderer::put(Encoder& encoder, std::size_t row, std::size_t column, const Cell& cell) {
+    move_to(encoder, row, column);
+    set_style(encoder, cell.style);
+    if (cell.glyph & GraphemePool::INTERNED)
+        *encoder.out += graphemes().get(cell.glyph);
+    else
+        utf8_append(*encoder.out, cell.glyph);
+
+    // a wide glyph covers its tail as well
+    const std::size_t columns = back_.columns();
+    const std::size_t width = column + 1 < columns && back_.glyphs_[row * columns + column + 1] == CellBuffer::WIDE_TAIL ? 2 : 1;
+
+    // past the last column the cursor sits in the pending wrap state, don't guess where it is
+    encoder.cursor_column += width;
+    if (encoder.cursor_column >= columns)
+        encoder.cursor_known = false;
+    return width;
+}
+
+std::size_t Term::Renderer::put_run(Encoder& encoder, std::size_t row, std::size_t column) {
+    std::string& out = *encoder.out;
+    const Cell cell = back_.at(row, column);
+    const std::size_t columns = back_.columns();
+
+    // the tail of a wide glyph changed on its own, write the whole glyph again
+    if (cell.glyph == CellBuffer::WIDE_TAIL && column > 0) {
+        const std::size_t width = put(encoder, row, column - 1, back_.at(row, column - 1));
+        encoder.cells += width;
+        front_.copy_cells(back_, row, column - 1, width);
+        return 1;
+    }
+
+    const std::size_t first = row * columns + column;
+    std::size_t length = 1;
+    while (column + length < columns && back_.glyphs_[first + length] == cell.glyph && back_.fg_[first + length] == back_.fg_[first]
+           && back_.bg_[first + length] == back_.bg_[first] && back_.attrs_[first + length] == cell.style.attrs)
+        length++;
+
+    // erased cells are spaces with the current background and no other attributes
+    const bool blank = cell.glyph == U' ' && cell.style.attrs == 0;
+    const std::size_t glyph_size = encoded_size(cell.glyph);
+
+    if (blank && column + length == columns && length > 3) {
+        move_to(encoder, row, column);
+        set_style(encoder, cell.style);
+        out += "\033[K"; // EL, the cursor stays
+    } else if (blank && length > 3 + count_digits(length)) {
+        move_to(encoder, row, column);
+        set_style(encoder, cell.style);
+        out += "\033[";
+        append_number(out, length);
+        out += 'X'; // ECH, the cursor stays
+    } else if (repeat_ && !(cell.glyph & GraphemePool::INTERNED) // REP would only repeat a grapheme's last codepoint
+               && (length - 1) * glyph_size > 3 + count_digits(length - 1)) {
+        put(encoder, row, column, cell);
+        out += "\033["; // REP repeats the last character written
+        append_number(out, length - 1);
+        out += 'b';
+        encoder.cursor_column += length - 1;
+        if (encoder.cursor_column >= columns)
+            encoder.cursor_known = false;
+    } else {
+        // not worth it, the rest of the run may not even have changed
+        length = put(encoder, row, column, cell);
+    }
+
+    encoder.cells += length;
+    front_.copy_cells(back_, row, column, length);
+    return length;
+}
+
+void Term::Renderer::encode_rows(Encoder& encoder, std::size_t first, std::size_t last) {
+    for (std::size_t row = first; row < last; row++) {
+        if (back_.same_row(front_, row))
+            continue;
+        for (std::size_t column = 0; column < back_.columns();) {
+            if (back_.same_cell(front_, row, column))
+                column++;
+            else
+                column += put_run(encoder, row, column);
+        }
+    }
+}
+
+void Term::Renderer::encode_bands() {
+    static constexpr std::size_t MIN_CELLS = 16384; // smaller frames aren't worth waking the workers for
+    static constexpr std::size_t MIN_ROWS = 4;      // per band
+
+    const std::size_t rows = back_.rows();
+    std::size_t bands = workers_ ? std::min(workers_->size() * 2, rows / MIN_ROWS) : 1;
+    if (bands < 2 || rows * back_.columns() < MIN_CELLS) {
+        encode_rows(encoder_, 0, rows);
+        return;
+    }
+
+    // every band starts from an unknown cursor and the default pen, the joins are fixed up below
+    if (bands_.size() != bands)
+        bands_.resize(bands);
+    for (std::size_t i = 0; i < bands; i++) {
+        Encoder& band = bands_[i];
+        band.first_row = rows * i / bands;
+        band.last_row = rows * (i + 1) / bands;
+        band.out = &band.buffer;
+        band.buffer.clear();
+        band.cursor_known = false;
+        band.styles.trim();
+        band.pen = CellStyle();
+        band.pen_id = band.styles.intern(band.pen);
+        band.cells = 0;
+    }
+    // only captures this, small enough for std::function to keep inline
+    workers_->run(bands, [this](std::size_t i) { encode_rows(bands_[i], bands_[i].first_row, bands_[i].last_row); });
+
+    for (Encoder& band : bands_) {
+        if (band.buffer.empty())
+            continue;
+        set_style(encoder_, CellStyle());
+        *encoder_.out += band.buffer;
+        encoder_.cursor_row = band.cursor_row;
+        encoder_.cursor_column = band.cursor_column;
+        encoder_.cursor_known = band.cursor_known;
+        encoder_.pen = band.pen;
+        encoder_.pen_id = encoder_.styles.intern(band.pen);
+        encoder_.cells += band.cells;
+    }
+    stats_.bands = bands;
+}
+
+void Term::Renderer::apply_scroll(Encoder& encoder, const CellBuffer::Scroll& scroll) {
+    std::string& out = *encoder.out;
+    const std::size_t count = static_cast<std::size_t>(scroll.lines > 0 ? scroll.lines : -scroll.lines);
+
+    // the rows scrolled in are erased with the current background
+    set_style(encoder, CellStyle());
+
+    if (scroll.bottom == back_.rows()) {
+        // down to the last row DL/IL at the top row do the same without touching the margins
+        move_to(encoder, scroll.top, 0);
+        out += "\033[";
+        append_number(out, count);
+        out += scroll.lines > 0 ? 'M' : 'L';
+        encoder.cursor_column = 0; // both return the cursor to the first column
+    } else {
+        out += "\033[";
+        append_number(out, scroll.top + 1);
+        out += ';';
+        append_number(out, scroll.bottom);
+        out += "r\033[";
+        append_number(out, count);
+        out += scroll.lines > 0 ? 'S' : 'T';
+        out += "\033[r";
+
+        // setting (and resetting) the margins homes the cursor
+        encoder.cursor_row = 0;
+        encoder.cursor_column = 0;
+        encoder.cursor_known = true;
+    }
+
+    front_.shift_rows(scroll.top, scroll.bottom, scroll.lines);
+    if (count < scroll.bottom - scroll.top)
+        stats_.scrolled_rows += scroll.bottom - scroll.top - count;
+}
+
+void Term::Renderer::detect_moves(Encoder& encoder) {
+    static constexpr int MAX_MOVES = 8; // per frame
+
+    const std::size_t rows = back_.rows();
+    front_hashes_.resize(rows);
+    back_hashes_.resize(rows);
+    for (std::size_t row = 0; row < rows; row++) {
+        front_hashes_[row] = front_.row_hash(row);
+        back_hashes_[row] = back_.row_hash(row);
+    }
+    const std::uint64_t blank = blank_hash_;
+
+    for (int move = 0; move < MAX_MOVES; move++) {
+        // the block of rows whose move repairs the most rows: back rows [best_to, +best_length) show
+        // what front rows [best_from, +best_length) show now
+        std::size_t best_from = 0, best_to = 0, best_length = 0;
+        long best_gain = 0;
+
+        for (std::size_t to = 0; to < rows;) {
+            const std::uint64_t hash = back_hashes_[to];
+            if (hash == front_hashes_[to] || hash == blank) {
+                to++;
+                continue;
+            }
+
+            // only rows that appear once on screen are anchors, repeated rows are ambiguous
+            std::size_t from = rows;
+            bool unique = true;
+            for (std::size_t row = 0; row < rows && unique; row++) {
+                if (front_hashes_[row] == hash) {
+                    unique = from == rows;
+                    from = row;
+                }
+            }
+            if (from == rows || !unique) {
+                to++;
+                continue;
+            }
+
+            std::size_t length = 1;
+            while (to + length < rows && from + length < rows && back_hashes_[to + length] == front_hashes_[from + length])
+                length++;
+
+            // rows the move fixes minus rows in the scrolled band that were right and get blanked
+            const std::size_t top = std::min(from, to), bottom = std::max(from, to) + length;
+            long gain = 0;
+            for (std::size_t row = top; row < bottom; row++) {
+                const bool in_block = row >= to && row < to + length;
+                if (in_block && back_hashes_[row] != front_hashes_[row])
+                    gain++;
+                else if (!in_block && back_hashes_[row] == front_hashes_[row] && back_hashes_[row] != blank)
+                    gain--;
+            }
+
+            if (gain > best_gain) {
+                best_gain = gain;
+                best_from = from;
+                best_to = to;
+                best_length = length;
+            }
+            to += length;
+        }
+
+        if (best_gain <= 0)
+            break;
+
+        const CellBuffer::Scroll scroll{std::min(best_from, best_to), std::max(best_from, best_to) + best_length,
+                                        static_cast<int>(best_from) - static_cast<int>(best_to)};
+        apply_scroll(encoder, scroll);
+
+        // keep the front hashes in step with front_
+        const auto first = front_hashes_.begin() + static_cast<std::ptrdiff_t>(scroll.top);
+        const auto last = front_hashes_.begin() + static_cast<std::ptrdiff_t>(scroll.bottom);
+        const std::ptrdiff_t count = scroll.lines > 0 ? scroll.lines : -scroll.lines;
+        if (scroll.lines > 0) {
+            std::copy(first + count, last, first);
+            std::fill(last - count, last, blank);
+        } else {
+            std::copy_backward(first, last - count, last);
+            std::fill(first, first + count, blank);
+        }
+    }
+}
+
+void Term::Renderer::estimate_costs() {
+    // what a cursor jump and an erase roughly take, SGR changes cost about the same either way and are left out
+    static constexpr std::size_t MOVE = 6;
+    static constexpr std::size_t ERASE = 4;
+
+    const std::size_t rows = back_.rows(), columns = back_.columns();
+    std::size_t incremental = 0;
+    for (std::size_t row = 0; row < rows; row++) {
+        if (back_.same_row(front_, row))
+            continue;
+
+        // every run of changed cells needs a jump, blanks in it go with one erase
+        bool in_run = false, erasing = false;
+        for (std::size_t column = 0, i = row * columns; column < columns; column++, i++) {
+            if (back_.same_cell(front_, row, column)) {
+                in_run = erasing = false;
+                continue;
+            }
+            if (!in_run)
+                incremental += MOVE;
+            in_run = true;
+
+            const bool blank = back_.glyphs_[i] == U' ' && back_.attrs_[i] == 0;
+            if (blank && !erasing)
+                incremental += ERASE;
+            else if (!blank)
+                incremental += encoded_size(back_.glyphs_[i]);
+            erasing = blank;
+        }
+    }
+
+    // a repaint starts from a cleared screen and draws everything that isn't a default blank, it stops
+    // counting as soon as it can't win
+    std::size_t full = 7; // CSI 0 m CSI 2 J
+    for (std::size_t i = 0; i < rows * columns && full < incremental; i++) {
+        const bool blank = back_.glyphs_[i] == U' ' && back_.attrs_[i] == 0 && back_.bg_[i] == 0;
+        if (blank)
+            continue;
+        if (i % columns == 0 || (back_.glyphs_[i - 1] == U' ' && back_.attrs_[i - 1] == 0 && back_.bg_[i - 1] == 0))
+            full += MOVE;
+        full += encoded_size(back_.glyphs_[i]);
+    }
+
+    stats_.incremental_estimate = incremental;
+    stats_.full_estimate = full;
+}
+
+void Term::Renderer::begin_repaint(Encoder& encoder) {
+    *encoder.out += "\033[0m\033[2J";
+    encoder.pen = CellStyle();
+    encoder.pen_id = encoder.styles.intern(encoder.pen);
+    encoder.cursor_known = false;
+    front_.clear();
+    stats_.full_redraw = true;
+}
+
+void Term::Renderer::present() {
+    Encoder& encoder = encoder_;
+    std::string& out = terminal_.output();
+    const std::size_t start = out.size();
+    encoder.out = &out;
+    encoder.cells = 0;
+    encoder.cursor_known = false; // anything may have moved it since the last frame, the first move is a CUP
+    stats_ = Stats();
+    if (encoder.styles.trim() || encoder.styles.size() == 0)
+        encoder.pen_id = encoder.styles.intern(encoder.pen);
+
+    if (repaint_) {
+        begin_repaint(encoder);
+        repaint_ = false;
+    } else {
+        for (const CellBuffer::Scroll& scroll : back_.scrolls())
+            apply_scroll(encoder, scroll);
+        detect_moves(encoder);
+
+        // i.e. a tab switch, clearing and drawing the new screen beats patching the old one
+        estimate_costs();
+        if (stats_.full_estimate < stats_.incremental_estimate) {
+            out.resize(start); // the scrolls are moot after a clear
+            stats_.scrolled_rows = 0;
+            begin_repaint(encoder);
+        }
+    }
+    back_.clear_scrolls();
+
+    encode_bands();
+
+    // leave the terminal with the default style for whatever gets printed next
+    set_style(encoder, CellStyle());
+
+    stats_.cells = encoder.cells;
+    stats_.bytes = out.size() - start;
+    if (&terminal_ == &Term::terminal())
+        Cursor::invalidate();
+    terminal_.flush();
+    frame_arena().reset();
+}
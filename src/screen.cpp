@@ -3,30 +3,114 @@
 #include "headers/screen.h"
 
 #include <cerrno>
+#include <csignal>
 #include <cstdio>
 #include <string>
+#include <fcntl.h>
+#include <signal.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <iostream>
 #include <termios.h>
 
-inline void Screen::clear()         { std::cerr << "\033[2J\033[H" << std::flush; }
+/*********************** RESIZE TRACKING ***********************/
+static Screen::Size cached_size{0, 0};
+static volatile std::sig_atomic_t size_dirty = 1;
+static volatile std::sig_atomic_t resize_count = 0;
+static int resize_pipe[2] = {-1, -1};
+static struct sigaction previous_sigwinch;
+
+static void on_sigwinch(int signal, siginfo_t* info, void* context) {
+    int saved_errno = errno;
+    size_dirty = 1;
+    resize_count = resize_count + 1;
+    if (resize_pipe[1] != -1)
+        (void)!write(resize_pipe[1], "", 1); // a full pipe already has a wakeup pending
+    errno = saved_errno;
+
+    // chain to whatever handler was installed before ours, with the same arguments if it takes them
+    if (previous_sigwinch.sa_flags & SA_SIGINFO)
+        previous_sigwinch.sa_sigaction(signal, info, context);
+    else if (previous_sigwinch.sa_handler != SIG_DFL && previous_sigwinch.sa_handler != SIG_IGN)
+        previous_sigwinch.sa_handler(signal);
+}
+
+static void install_sigwinch_handler() {
+    static bool installed = false;
+    if (installed)
+        return;
+    installed = true;
+
+    if (pipe(resize_pipe) == 0) {
+        for (int fd : resize_pipe) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    } else {
+        resize_pipe[0] = resize_pipe[1] = -1; // size() still works, there just won't be wakeups
+    }
+
+    struct sigaction action = {};
+    action.sa_sigaction = on_sigwinch;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigaction(SIGWINCH, &action, &previous_sigwinch);
+}
+/*************************************************************/
+
+inline void Screen::clear()         { std::cerr << "\033[2J"; Cursor::home(); }
 inline void Screen::clear_to_eol()  { std::cerr << "\033[0K" << std::flush; }
 inline void Screen::clear_to_eof()  { std::cerr << "\033[0J" << std::flush; }
 inline void Screen::clear_to_sol()  { std::cerr << "\033[1K" << std::flush; }
 inline void Screen::clear_to_sof()  { std::cerr << "\033[1J" << std::flush; }
 inline void Screen::clear_line()    { std::cerr << "\033[2K" << std::flush; }
 inline void Screen::clear_partial(const std::size_t& row, const std::size_t& column, const std::size_t& width, const std::size_t& height) {
-    cursor_pos_t oldpos = Cursor::position();
-    std::string spaces(width, ' ');
+    std::string out;
+    Screen::clear_partial(out, row, column, width, height);
+    std::cerr << out << std::flush;
+}
+
+static bool rectangular_erase = false;
+
+void Screen::use_rectangular_erase(bool enabled) { rectangular_erase = enabled; }
+
+void Screen::clear_partial(std::string& out, const std::size_t& row, const std::size_t& column, const std::size_t& width, const std::size_t& height) {
+    if (width == 0 || height == 0)
+        return;
 
-    for (int i = 0; i < height; i++) {
-        Cursor::set(row + i, column);
-        std::cout << spaces;
+    // DECERA: CSI top ; left ; bottom ; right $ z
+    if (rectangular_erase) {
+        out += "\033[" + std::to_string(row) + ';' + std::to_string(column) + ';'
+             + std::to_string(row + height - 1) + ';' + std::to_string(column + width - 1) + "$z";
+        return;
     }
-    Cursor::set(oldpos.row, oldpos.column);
+
+    // ECH (CSI n X) blanks n cells from the cursor without moving it, so the
+    // cursor is saved and restored around the rows instead of tracked
+    const std::string erase = "\033[" + std::to_string(width) + 'X';
+    out += "\0337";
+    for (std::size_t i = 0; i < height; i++)
+        out += "\033[" + std::to_string(row + i) + ';' + std::to_string(column) + 'H' + erase;
+    out += "\0338";
+}
+
+inline void Screen::set_scroll_region(const std::size_t& top, const std::size_t& bottom) {
+    std::cerr << "\033[" << top << ';' << bottom << 'r';
+    Cursor::home(); // DECSTBM already did, this keeps the tracked position right
 }
+inline void Screen::reset_scroll_region()                  { std::cerr << "\033[r"; Cursor::home(); }
+inline void Screen::scroll_up(const std::size_t& lines)    { std::cerr << "\033[" << lines << 'S' << std::flush; }
+inline void Screen::scroll_down(const std::size_t& lines)  { std::cerr << "\033[" << lines << 'T' << std::flush; }
 
+void Screen::scroll_region(std::string& out, const std::size_t& top, const std::size_t& bottom, int lines) {
+    if (lines == 0 || top > bottom)
+        return;
+
+    // DECSTBM moves the cursor home, DECSC/DECRC put it back
+    out += "\0337\033[" + std::to_string(top) + ';' + std::to_string(bottom) + 'r';
+    out += "\033[" + std::to_string(lines > 0 ? lines : -lines) + (lines > 0 ? 'S' : 'T');
+    out += "\033[r\0338";
+}
 
 
 //void Screen::save()         { std::cerr << "\033[?1049h" << std::flush; }
@@ -34,13 +118,40 @@ inline void Screen::clear_partial(const std::size_t& row, const std::size_t& col
 void Screen::save()         { std::cerr << "\033[?47h" << std::flush; }
 void Screen::restore()      { std::cerr << "\033[?47l" << std::flush; }
 Screen::Size Screen::size() {
+    install_sigwinch_handler();
+    if (!size_dirty)
+        return cached_size;
+
+    // clear the flag first so a resize during the ioctl is picked up by the next call
+    size_dirty = 0;
     struct winsize ws;
-    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == -1 || ws.ws_col == 0)
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == -1 || ws.ws_col == 0) {
+        size_dirty = 1;
         throw Term::Exception("Couldn't get terminal size. " + std::string(Term::is_stdout_a_tty() ? "" : "(STDOUT IS NOT A TTY!)"));
-    else {
-        Screen::Size term_size;
-        term_size.rows = ws.ws_row;
-        term_size.columns = ws.ws_col;
-        return term_size;
+    } else {
+        cached_size.rows = ws.ws_row;
+        cached_size.columns = ws.ws_col;
+        return cached_size;
     }
 }
+
+int Screen::resizes() {
+    install_sigwinch_handler();
+    return resize_count;
+}
+
+int Screen::resize_fd() {
+    install_sigwinch_handler();
+    return resize_pipe[0];
+}
+
+bool Screen::resized() {
+    if (resize_pipe[0] == -1)
+        return false;
+
+    char buf[64];
+    bool any = false;
+    while (read(resize_pipe[0], buf, sizeof(buf)) > 0)
+        any = true;
+    return any;
+}
@@ -0,0 +1,287 @@
+#include "headers/term.h"
+#include "headers/color.h"
+#include "headers/cursor.h"
+#include "headers/unicode.h"
+#include "headers/buffer.h"
+#include "headers/border.h"
+#include "headers/table.h"
+
+#include <algorithm>
+#include <string>
+
+Term::Table::Table(BorderStyle border) : border_(border), header_style_(CellStyle().with(Style::BOLD)) {}
+
+void Term::Table::add_column(std::size_t column) {
+    if (column >= widths_.size()) {
+        widths_.resize(column + 1, 0);
+        min_widths_.resize(column + 1, 0);
+        align_.resize(column + 1, Align::LEFT);
+    }
+}
+
+void Term::Table::measure(std::size_t column, std::string_view text, std::uint32_t& width) {
+    width = static_cast<std::uint32_t>(display_width(text));
+    add_column(column);
+    widths_[column] = std::max<std::size_t>(widths_[column], width);
+}
+
+void Term::Table::set_headers(std::initializer_list<std::string_view> headers, Align align) {
+    headers_.assign(headers.begin(), headers.end());
+    header_widths_.resize(headers_.size());
+    header_align_.assign(headers_.size(), align);
+    for (std::size_t i = 0; i < headers_.size(); i++)
+        measure(i, headers_[i], header_widths_[i]);
+}
+
+void Term::Table::add_row(std::initializer_list<std::string_view> row) {
+    add_row(row.begin(), row.size());
+}
+
+void Term::Table::add_row(const std::string_view* cells, std::size_t count) {
+    const std::size_t first = cells_.size();
+    cells_.insert(cells_.end(), cells, cells + count);
+    cell_widths_.resize(first + count);
+    for (std::size_t i = 0; i < count; i++)
+        measure(i, cells[i], cell_widths_[first + i]);
+    row_start_.push_back(cells_.size());
+}
+
+void Term::Table::clear_rows() {
+    cells_.clear();
+    cell_widths_.clear();
+    row_start_.assign(1, 0);
+    // the widths only shrink back to the headers' and the minimums
+    widths_ = min_widths_;
+    for (std::size_t i = 0; i < headers_.size(); i++)
+        widths_[i] = std::max<std::size_t>(widths_[i], header_widths_[i]);
+}
+
+void Term::Table::set_align(std::size_t column, Align align) {
+    add_column(column);
+    align_[column] = align;
+}
+
+void Term::Table::set_min_width(std::size_t column, std::size_t width) {
+    add_column(column);
+    min_widths_[column] = width;
+    widths_[column] = std::max(widths_[column], width);
+}
+
+void Term::Table::set_borders(bool borders) {
+    borders_ = borders;
+}
+
+std::size_t Term::Table::width() const {
+    if (widths_.empty())
+        return 0;
+
+    std::size_t width = 0;
+    for (std::size_t w : widths_)
+        width += w;
+    // "│ a │ b │" or "a  b"
+    return borders_ ? width + 3 * widths_.size() + 1 : width + 2 * (widths_.size() - 1);
+}
+
+std::size_t Term::Table::height() const {
+    if (widths_.empty())
+        return 0;
+    const std::size_t header = headers_.empty() ? 0 : 1;
+    return borders_ ? rows() + 2 * header + 2 : rows() + header;
+}
+
+Term::Table::Line Term::Table::line_kind(std::size_t line, std::size_t& data_row) const {
+    const bool header = !headers_.empty();
+    if (!borders_) {
+        data_row = line - (header ? 1 : 0);
+        return header && line == 0 ? Line::HEADER : Line::ROW;
+    }
+
+    if (line == 0)
+        return Line::TOP;
+    if (line + 1 == height())
+        return Line::BOTTOM;
+    if (header && line == 1)
+        return Line::HEADER;
+    if (header && line == 2)
+        return Line::SEPARATOR;
+    data_row = line - (header ? 3 : 1);
+    return Line::ROW;
+}
+
+void Term::Table::draw_rule(CellBuffer& buffer, std::size_t row, std::size_t column, bool up, bool down) const {
+    const Cell line{border_glyph(border_, false, true, false, true), line_style_};
+    buffer.fill(row, column, 1, width(), line);
+
+    std::size_t x = column;
+    buffer.set(row, x, Cell{border_glyph(border_, up, true, down, false), line_style_});
+    for (std::size_t i = 0; i + 1 < widths_.size(); i++) {
+        x += widths_[i] + 3;
+        buffer.set(row, x, Cell{border_glyph(border_, up, true, down, true), line_style_});
+    }
+    buffer.set(row, column + width() - 1, Cell{border_glyph(border_, up, false, down, true), line_style_});
+}
+
+void Term::Table::draw_cells(CellBuffer& buffer, std::size_t row, std::size_t column, const std::string_view* text, const std::uint32_t* widths,
+                             std::size_t count, const CellStyle& style, const Align* align) const {
+    buffer.fill(row, column, 1, width(), Cell{U' ', style});
+
+    const std::size_t gap = borders_ ? 3 : 2;
+    std::size_t x = column;
+    if (borders_) {
+        const Cell line{border_glyph(border_, true, false, true, false), line_style_};
+        for (std::size_t i = 0; i < widths_.size(); i++) {
+            buffer.set(row, x, line);
+            x += widths_[i] + gap;
+        }
+        buffer.set(row, x, line);
+        x = column + 2;
+    }
+
+    for (std::size_t i = 0; i < widths_.size(); i++) {
+        if (i < count) {
+            const std::size_t room = widths_[i] - widths[i];
+            const std::size_t offset = align[i] == Align::RIGHT ? room : align[i] == Align::CENTER ? room / 2 : 0;
+            buffer.print(row, x + offset, text[i], style, widths[i]);
+        }
+        x += widths_[i] + gap;
+    }
+}
+
+void Term::Table::draw_line(CellBuffer& buffer, std::size_t row, std::size_t column, std::size_t line) const {
+    std::size_t data_row = 0;
+    switch (line_kind(line, data_row)) {
+    case Line::TOP: draw_rule(buffer, row, column, false, true); break;
+    case Line::SEPARATOR: draw_rule(buffer, row, column, true, true); break;
+    case Line::BOTTOM: draw_rule(buffer, row, column, true, false); break;
+    case Line::HEADER:
+        draw_cells(buffer, row, column, headers_.data(), header_widths_.data(), headers_.size(), header_style_, header_align_.data());
+        break;
+    case Line::ROW: {
+        const std::size_t first = row_start_[data_row];
+        draw_cells(buffer, row, column, cells_.data() + first, cell_widths_.data() + first, row_start_[data_row + 1] - first, cell_style_, align_.data());
+        break;
+    }
+    }
+}
+
+void Term::Table::draw(CellBuffer& buffer, std::size_t row, std::size_t column) const {
+    const std::size_t lines = std::min(height(), buffer.rows() > row ? buffer.rows() - row : 0);
+    for (std::size_t line = 0; line < lines; line++)
+        draw_line(buffer, row + line, column, line);
+}
+
+void Term::Table::print(std::ostream& out) const {
+    static constexpr std::size_t CHUNK = 256; // lines drawn at once, so large tables don't need a buffer as large
+    const std::size_t lines = height();
+    if (lines == 0)
+        return;
+
+    CellBuffer chunk(std::min(CHUNK, lines), width());
+    std::string text;
+    for (std::size_t first = 0; first < lines; first += CHUNK) {
+        const std::size_t count = std::min(CHUNK, lines - first);
+        text.clear();
+        for (std::size_t line = 0; line < count; line++) {
+            draw_line(chunk, line, 0, first + line);
+            text += chunk.text(line);
+            text.erase(text.find_last_not_of(' ') + 1);
+            text += '\n';
+        }
+        out << text;
+    }
+    out.flush();
+    Cursor::invalidate(); // the lines moved it
+}
+
+Term::TableView::TableView(std::initializer_list<std::string_view> headers, RowProvider provider, BorderStyle border)
+    : table_(border), provider_(std::move(provider)), selected_style_(CellStyle().with(Style::REVERSE)), cells_(headers.size()) {
+    table_.set_headers(headers);
+}
+
+void Term::TableView::estimate_widths() {
+    // what the old data widened the columns to goes, only the headers' widths stay
+    for (std::size_t c = 0; c < cells_.size(); c++)
+        table_.set_min_width(c, 0);
+    table_.clear_rows();
+
+    std::vector<std::size_t> widths(cells_.size(), 0);
+    const std::size_t samples = std::min(rows_, SAMPLES);
+    for (std::size_t i = 0; i < samples; i++) {
+        // spread over the whole data, the first rows alone tend to be alike
+        std::fill(cells_.begin(), cells_.end(), std::string_view());
+        provider_(i * rows_ / samples, cells_.data());
+        for (std::size_t c = 0; c < cells_.size(); c++)
+            widths[c] = std::max(widths[c], display_width(cells_[c]));
+    }
+    for (std::size_t c = 0; c < cells_.size(); c++)
+        table_.set_min_width(c, widths[c]);
+}
+
+void Term::TableView::set_row_count(std::size_t rows) {
+    rows_ = rows;
+    estimate_widths();
+    clamp();
+}
+
+void Term::TableView::clamp() {
+    if (rows_ == 0) {
+        first_ = selected_ = 0;
+        return;
+    }
+    selected_ = std::min(selected_, rows_ - 1);
+    first_ = std::min(first_, rows_ > page_ ? rows_ - page_ : 0);
+}
+
+void Term::TableView::scroll_to(std::size_t first) {
+    first_ = first;
+    clamp();
+}
+
+void Term::TableView::scroll_by(long rows) {
+    scroll_to(rows < 0 && static_cast<std::size_t>(-rows) > first_ ? 0 : first_ + static_cast<std::size_t>(rows));
+}
+
+void Term::TableView::select(std::size_t row) {
+    selected_ = row;
+    clamp();
+    if (selected_ < first_)
+        first_ = selected_;
+    else if (selected_ >= first_ + page_)
+        first_ = selected_ - page_ + 1;
+}
+
+void Term::TableView::move_selection(long rows) {
+    select(rows < 0 && static_cast<std::size_t>(-rows) > selected_ ? 0 : selected_ + static_cast<std::size_t>(rows));
+}
+
+void Term::TableView::draw(CellBuffer& buffer, std::size_t row, std::size_t column, std::size_t height) {
+    table_.clear_rows();
+    const std::size_t chrome = table_.height(); // header and borders
+    page_ = height > chrome ? height - chrome : 1;
+    clamp();
+
+    const std::size_t last = std::min(rows_, first_ + page_);
+    for (std::size_t r = first_; r < last; r++) {
+        std::fill(cells_.begin(), cells_.end(), std::string_view());
+        provider_(r, cells_.data());
+        table_.add_row(cells_.data(), cells_.size());
+    }
+
+    // what scrolled into view widens the columns for good
+    for (std::size_t c = 0; c < cells_.size(); c++)
+        table_.set_min_width(c, table_.column_width(c));
+
+    table_.draw(buffer, row, column);
+    const std::size_t drawn = table_.height(), width = table_.width();
+    if (drawn < height)
+        buffer.fill(row + drawn, column, height - drawn, std::max(width, drawn_width_), Cell{});
+    if (width < drawn_width_)
+        buffer.fill(row, column + width, std::min(drawn, height), drawn_width_ - width, Cell{});
+    drawn_width_ = width;
+
+    if (selected_ >= first_ && selected_ < last) {
+        const bool borders = table_.borders();
+        const std::size_t line = row + drawn - (borders ? 1 : 0) - (last - selected_);
+        buffer.restyle(line, column + (borders ? 1 : 0), width - (borders ? 2 : 0), selected_style_);
+    }
+}
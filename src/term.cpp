@@ -1,4 +1,7 @@
 #include "headers/term.h"
+#include "headers/input.h"
+#include "headers/screen.h"
+#include "headers/terminal.h"
 
 #include <cerrno>
 #include <cstdio>
@@ -8,9 +11,6 @@
 #include <iostream>
 #include <termios.h>
 
-static struct termios original_termios;
-static bool __is_raw_mode_enabled = false; // weird name to avoid possible conflict
-
 /********************* NAMESPACE PRIVATE *********************/
 std::string Term::Private::getenv(const std::string& env) {
     if (std::getenv(env.c_str()) != nullptr) 
@@ -32,37 +32,10 @@ termios Term::get_term_attributes() {
     return term;
 }
 
-inline void Term::enable_raw_mode() {
-    if (__is_raw_mode_enabled)
-        return;
-    struct termios raw;
-
-    tcgetattr(STDIN_FILENO, &original_termios);
-    raw = original_termios;
-    raw.c_lflag &= ~(ECHO | ICANON | ISIG | IEXTEN);
-    raw.c_iflag &= ~(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
-    raw.c_cflag |= (CS8);
-    //raw.c_oflag &= ~(OPOST);
-    raw.c_cc[VMIN] = 1;
-    raw.c_cc[VTIME] = 0;
-
-    tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
-    __is_raw_mode_enabled = true;
-}
-
-inline void Term::disable_raw_mode() {
-    if (!__is_raw_mode_enabled)
-        return;
-    tcsetattr(STDIN_FILENO, TCSAFLUSH, &original_termios);
-    __is_raw_mode_enabled = false;
-}
-
-inline bool Term::is_raw_mode() {
-    struct termios current_termios;
-    tcgetattr(STDIN_FILENO, &current_termios);
-
-    return __is_raw_mode_enabled && (current_termios.c_lflag & ICANON) == 0;
-}
+// the free functions work on the process' own terminal
+inline void Term::enable_raw_mode()  { Term::terminal().enable_raw_mode(); }
+inline void Term::disable_raw_mode() { Term::terminal().disable_raw_mode(); }
+inline bool Term::is_raw_mode()      { return Term::terminal().is_raw_mode(); }
 
 
 bool Term::stdin_connected()  { return Term::is_stdin_a_tty(); }
@@ -0,0 +1,125 @@
+#include "headers/term.h"
+#include "headers/input.h"
+#include "headers/screen.h"
+#include "headers/terminal.h"
+
+#include <cerrno>
+#include <string>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <iostream>
+#include <termios.h>
+
+Term::Terminal::Terminal(int in_fd, int out_fd) : in_fd_(in_fd), out_fd_(out_fd) {}
+
+Term::Terminal::~Terminal() {
+    disable_raw_mode();
+}
+
+Term::Terminal& Term::terminal() {
+    static Terminal process_terminal(STDIN_FILENO, STDOUT_FILENO);
+    return process_terminal;
+}
+
+/************************** TERMIOS **************************/
+void Term::Terminal::enable_raw_mode() {
+    if (raw_mode_)
+        return;
+    struct termios raw;
+
+    if (tcgetattr(in_fd_, &original_termios_) != 0)
+        throw Term::Exception("tcgetattr() failed");
+    raw = original_termios_;
+    raw.c_lflag &= ~(ECHO | ICANON | ISIG | IEXTEN);
+    raw.c_iflag &= ~(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
+    raw.c_cflag |= (CS8);
+    //raw.c_oflag &= ~(OPOST);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+
+    tcsetattr(in_fd_, TCSAFLUSH, &raw);
+    raw_mode_ = true;
+}
+
+void Term::Terminal::disable_raw_mode() {
+    if (!raw_mode_)
+        return;
+    tcsetattr(in_fd_, TCSAFLUSH, &original_termios_);
+    raw_mode_ = false;
+}
+
+bool Term::Terminal::is_raw_mode() const {
+    struct termios current_termios;
+    if (tcgetattr(in_fd_, &current_termios) != 0)
+        return false;
+
+    return raw_mode_ && (current_termios.c_lflag & ICANON) == 0;
+}
+/*************************************************************/
+
+
+/*************************** OUTPUT **************************/
+bool Term::Terminal::flush() {
+    // anything already sent through iostreams has to reach the terminal first
+    if (out_fd_ == STDOUT_FILENO || out_fd_ == STDERR_FILENO)
+        std::cout.flush();
+
+    while (written_ < output_.size()) {
+        ssize_t n = ::write(out_fd_, output_.data() + written_, output_.size() - written_);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return false;
+            throw Term::Exception("write() to terminal failed");
+        }
+        written_ += static_cast<std::size_t>(n);
+    }
+
+    output_.clear(); // keeps the capacity, steady state output doesn't allocate
+    written_ = 0;
+    return true;
+}
+/*************************************************************/
+
+
+/*************************** INPUT ***************************/
+bool Term::Terminal::read_input() {
+    char buf[READ_SIZE];
+    ssize_t n;
+
+    do {
+        n = ::read(in_fd_, buf, sizeof(buf));
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return true;
+    if (n <= 0)
+        return false;
+
+    decoder_.feed(buf, static_cast<std::size_t>(n));
+    return true;
+}
+
+bool Term::Terminal::next_event(Event& event) { return decoder_.next(event); }
+/*************************************************************/
+
+
+/**************************** SIZE ***************************/
+Screen::Size Term::Terminal::size() {
+    if (!size_valid_ || size_resizes_ != Screen::resizes())
+        refresh_size();
+    return size_;
+}
+
+void Term::Terminal::refresh_size() {
+    size_resizes_ = Screen::resizes(); // first, so a resize during the ioctl is picked up by the next call
+    struct winsize ws;
+    if (ioctl(out_fd_, TIOCGWINSZ, &ws) == -1 || ws.ws_col == 0)
+        throw Term::Exception("Couldn't get terminal size.");
+
+    size_.rows = ws.ws_row;
+    size_.columns = ws.ws_col;
+    size_valid_ = true;
+}
+/*************************************************************/
@@ -0,0 +1,136 @@
+#include "headers/term.h"
+#include "headers/color.h"
+#include "headers/cursor.h"
+#include "headers/unicode.h"
+#include "headers/input.h"
+#include "headers/screen.h"
+#include "headers/terminal.h"
+#include "headers/buffer.h"
+#include "headers/renderer.h"
+#include "headers/text.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+/*********************** TEXT VIEW ***********************/
+std::size_t Term::TextView::width() const {
+    return display_width(content_);
+}
+
+Term::TextView Term::TextView::substr(std::size_t pos, std::size_t count) const {
+    pos = std::min(pos, content_.size());
+    count = std::min(count, content_.size() - pos);
+    const std::size_t start = offset_ + pos, stop = start + count;
+    if (count == 0)
+        return TextView(content_.substr(pos, 0), first_, first_, start);
+
+    // the span holding the first byte and the one holding the last
+    const auto ends_before = [](const StyleSpan& span, std::size_t at) { return span.end <= at; };
+    const StyleSpan* first = std::lower_bound(first_, last_, start, ends_before);
+    const StyleSpan* last = std::lower_bound(first, last_, stop - 1, ends_before);
+    return TextView(content_.substr(pos, count), first, last + 1, start);
+}
+
+Term::TextView Term::TextView::clip(std::size_t columns) const {
+    // graphemes are counted the way CellBuffer::print() lays them out
+    std::size_t width = 0;
+    bool joiner = false; // the last codepoint was a ZWJ
+    std::size_t i = 0;
+    while (i < content_.size()) {
+        char32_t codepoint;
+        std::size_t used = utf8_decode(content_.data() + i, content_.size() - i, codepoint);
+        if (used == 0) { // cut short at the end of the text
+            codepoint = 0xfffd;
+            used = content_.size() - i;
+        }
+
+        const bool joins = joiner || extends_grapheme(codepoint);
+        if (is_control(codepoint) || (joins && width == 0)) {
+            joiner = false;
+        } else {
+            if (!joins) {
+                const std::size_t cells = codepoint_width(codepoint) == 2 ? 2 : 1;
+                if (width + cells > columns)
+                    break;
+                width += cells;
+            }
+            joiner = codepoint == 0x200d;
+        }
+        i += used;
+    }
+    return substr(0, i);
+}
+
+std::size_t Term::TextView::draw(CellBuffer& buffer, std::size_t row, std::size_t column, std::size_t width) const {
+    if (row >= buffer.rows() || column >= buffer.columns())
+        return 0;
+
+    // clipped up front, so no run is cut short and leaves the ones after it drawing past the cut
+    std::size_t written = 0;
+    clip(std::min(width, buffer.columns() - column)).for_each_run([&](std::string_view run, const CellStyle& style) {
+        written += buffer.print(row, column + written, run, style);
+    });
+    return written;
+}
+
+void Term::TextView::print(std::ostream& out) const {
+    std::string encoded;
+    encoded.reserve(content_.size() + 16 * static_cast<std::size_t>(last_ - first_));
+
+    CellStyle pen;
+    for_each_run([&](std::string_view run, const CellStyle& style) {
+        append_sgr(encoded, pen, style);
+        encoded += run;
+        pen = style;
+    });
+    append_sgr(encoded, pen, CellStyle());
+    out.write(encoded.data(), static_cast<std::streamsize>(encoded.size()));
+    Cursor::invalidate(); // the text moved it
+}
+
+std::ostream& Term::operator<<(std::ostream& out, const TextView& text) {
+    text.print(out);
+    return out;
+}
+/*************************************************************/
+
+/*************************** TEXT ***************************/
+Term::Text& Term::Text::append(std::string_view text, const CellStyle& style) {
+    if (text.empty())
+        return *this;
+
+    content_ += text;
+    if (!spans_.empty() && spans_.back().style == style)
+        spans_.back().end = static_cast<std::uint32_t>(content_.size());
+    else
+        spans_.push_back(StyleSpan{static_cast<std::uint32_t>(content_.size()), style});
+    return *this;
+}
+
+Term::Text& Term::Text::append(const TextView& text) {
+    const char* data = text.content().data();
+    const std::less<const char*> less; // the pointers may be to different strings
+    if (text.empty() || less(data, content_.data()) || !less(data, content_.data() + content_.size())) {
+        text.for_each_run([this](std::string_view run, const CellStyle& style) { append(run, style); });
+        return *this;
+    }
+
+    // a view of this text: growing would move what it points at, so make all the room first and take the
+    // view again from where it was, a copy can't take more spans than there are
+    const std::size_t pos = static_cast<std::size_t>(data - content_.data()), size = text.size();
+    reserve(content_.size() + size, spans_.size() * 2);
+    view().substr(pos, size).for_each_run([this](std::string_view run, const CellStyle& style) { append(run, style); });
+    return *this;
+}
+
+void Term::Text::reserve(std::size_t bytes, std::size_t spans) {
+    content_.reserve(bytes);
+    spans_.reserve(spans);
+}
+
+void Term::Text::clear() {
+    content_.clear();
+    spans_.clear();
+}
+/*************************************************************/
@@ -0,0 +1,198 @@
+#include "headers/term.h"
+#include "headers/unicode.h"
+
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+std::size_t Term::utf8_decode(const char* data, std::size_t length, char32_t& codepoint) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    const unsigned char lead = bytes[0];
+
+    if (lead < 0x80) {
+        codepoint = lead;
+        return 1;
+    }
+
+    std::size_t needed;
+    char32_t min;
+    if      ((lead & 0xe0) == 0xc0) { needed = 2; min = 0x80;    codepoint = lead & 0x1f; }
+    else if ((lead & 0xf0) == 0xe0) { needed = 3; min = 0x800;   codepoint = lead & 0x0f; }
+    else if ((lead & 0xf8) == 0xf0) { needed = 4; min = 0x10000; codepoint = lead & 0x07; }
+    else {
+        codepoint = 0xfffd; // stray continuation byte or invalid lead byte
+        return 1;
+    }
+
+    for (std::size_t i = 1; i < needed; i++) {
+        if (i >= length)
+            return 0;
+        if ((bytes[i] & 0xc0) != 0x80) {
+            codepoint = 0xfffd;
+            return 1;
+        }
+        codepoint = (codepoint << 6) | (bytes[i] & 0x3f);
+    }
+
+    // reject overlong encodings, UTF-16 surrogates and anything past the last plane
+    if (codepoint < min || codepoint > 0x10ffff || (codepoint >= 0xd800 && codepoint <= 0xdfff)) {
+        codepoint = 0xfffd;
+        return 1;
+    }
+    return needed;
+}
+
+void Term::utf8_append(std::string& out, char32_t codepoint) {
+    if (codepoint < 0x80) {
+        out += static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        out += static_cast<char>(0xc0 | (codepoint >> 6));
+        out += static_cast<char>(0x80 | (codepoint & 0x3f));
+    } else if (codepoint < 0x10000) {
+        out += static_cast<char>(0xe0 | (codepoint >> 12));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (codepoint & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | (codepoint >> 18));
+        out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (codepoint & 0x3f));
+    }
+}
+
+std::string Term::utf8_encode(char32_t codepoint) {
+    std::string result;
+    utf8_append(result, codepoint);
+    return result;
+}
+
+bool Term::extends_grapheme(char32_t codepoint) {
+    // everything the terminal draws in no columns of its own, controls aside
+    return codepoint >= 0xa0 && codepoint_width(codepoint) == 0;
+}
+
+namespace Term {
+namespace Private {
+// index of the lowest set bit of a nonzero mask
+unsigned lowest_bit(std::uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+// the length of the run of printable ASCII at the start of data, 16 bytes at a time where the CPU has vectors
+std::size_t ascii_run(const char* data, std::size_t length) {
+    std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i space = _mm_set1_epi8(0x20), del = _mm_set1_epi8(0x7f);
+    for (; i + 16 <= length; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        // a signed compare, so bytes from 0x80 up count as below the space along with the controls
+        const int stops = _mm_movemask_epi8(_mm_or_si128(_mm_cmplt_epi8(bytes, space), _mm_cmpeq_epi8(bytes, del)));
+        if (stops != 0)
+            return i + lowest_bit(static_cast<std::uint64_t>(stops));
+    }
+#elif defined(__aarch64__)
+    const uint8x16_t space = vdupq_n_u8(0x20), del = vdupq_n_u8(0x7f);
+    for (; i + 16 <= length; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i));
+        const uint8x16_t stops = vorrq_u8(vcltq_u8(bytes, space), vcgeq_u8(bytes, del));
+        // narrowed to 4 bits per byte, there is no movemask
+        const std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(stops), 4)), 0);
+        if (mask != 0)
+            return i + lowest_bit(mask) / 4;
+    }
+#endif
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    while (i < length && bytes[i] >= 0x20 && bytes[i] < 0x7f)
+        i++;
+    return i;
+}
+
+// the index just past the escape sequence whose ESC is at text[i], or the end of the text if it is cut short
+std::size_t skip_escape(std::string_view text, std::size_t i) {
+    if (++i >= text.size())
+        return i;
+
+    const char kind = text[i++];
+    if (kind == '[') { // CSI: parameter and intermediate bytes up to a final byte
+        while (i < text.size() && (text[i] < 0x40 || text[i] > 0x7e))
+            i++;
+        return i < text.size() ? i + 1 : i;
+    }
+    if (kind == ']' || kind == 'P' || kind == 'X' || kind == '^' || kind == '_') { // OSC, DCS and the other strings
+        for (; i < text.size(); i++) {
+            if (text[i] == '\a')
+                return i + 1;
+            if (text[i] == '\033' && i + 1 < text.size() && text[i + 1] == '\\') // ST
+                return i + 2;
+        }
+        return i;
+    }
+    // the rest are one character, after intermediates as in ESC ( B
+    if (kind >= 0x20 && kind <= 0x2f) {
+        while (i < text.size() && text[i] >= 0x20 && text[i] <= 0x2f)
+            i++;
+        return i < text.size() ? i + 1 : i;
+    }
+    return i;
+}
+
+// the columns text takes, escapes: ignoring the escape sequences in it
+std::size_t measure_width(std::string_view text, bool escapes) {
+    std::size_t width = 0;
+    bool joiner = false; // the last codepoint was a ZWJ
+    for (std::size_t i = 0; i < text.size();) {
+        const unsigned char byte = static_cast<unsigned char>(text[i]);
+        if (byte >= 0x20 && byte < 0x7f) {
+            const std::size_t run = ascii_run(text.data() + i, text.size() - i);
+            width += joiner ? run - 1 : run; // the first one joins the ZWJ
+            joiner = false;
+            i += run;
+            continue;
+        }
+        if (byte == 0x1b && escapes) { // the sequence takes no room and leaves a ZWJ before it pending
+            i = skip_escape(text, i);
+            continue;
+        }
+        if (byte < 0x80) { // controls and DEL
+            joiner = false;
+            i++;
+            continue;
+        }
+
+        char32_t codepoint;
+        std::size_t used = Term::utf8_decode(text.data() + i, text.size() - i, codepoint);
+        if (used == 0) { // cut short at the end of the text
+            codepoint = 0xfffd;
+            used = text.size() - i;
+        }
+        if (!joiner)
+            width += static_cast<std::size_t>(Term::codepoint_width(codepoint));
+        joiner = codepoint == 0x200d && width > 0; // a ZWJ with nothing before it is dropped like any mark
+        i += used;
+    }
+    return width;
+}
+} // namespace Private
+} // namespace Term
+
+std::size_t Term::display_width(std::string_view text) {
+    return Private::measure_width(text, false);
+}
+
+std::size_t Term::visible_width(std::string_view text) {
+    return Private::measure_width(text, true);
+}
@@ -0,0 +1,61 @@
+#include "headers/workers.h"
+
+Term::WorkerPool::WorkerPool(std::size_t threads) {
+    for (std::size_t i = 1; i < threads; i++)
+        threads_.emplace_back(&WorkerPool::work, this);
+}
+
+Term::WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_)
+        thread.join();
+}
+
+void Term::WorkerPool::work() {
+    std::size_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_)
+            return;
+
+        seen = generation_;
+        if (task_ == nullptr) // the job was over before this worker got to it
+            continue;
+        const std::function<void(std::size_t)>* task = task_;
+        const std::size_t tasks = tasks_;
+        active_++;
+        lock.unlock();
+
+        for (std::size_t i; (i = next_.fetch_add(1)) < tasks;)
+            (*task)(i);
+
+        lock.lock();
+        if (--active_ == 0)
+            idle_.notify_all();
+    }
+}
+
+void Term::WorkerPool::run(std::size_t tasks, const std::function<void(std::size_t)>& task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        tasks_ = tasks;
+        next_ = 0;
+        generation_++;
+    }
+    wake_.notify_all();
+
+    for (std::size_t i; (i = next_.fetch_add(1)) < tasks;)
+        task(i);
+
+    // workers still finishing their last task hold a pointer to task
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [&] { return active_ == 0; });
+    task_ = nullptr;
+    tasks_ = 0;
+}
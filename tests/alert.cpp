@@ -15,16 +15,13 @@ int main() {
     Key key;
     while ((key = Term::getkey()) != Key::CTRL_C) {
         if (key == Key::ENTER) {
-            alert("INFO", "ACKNOWLEDGE", 
-                  Term::style(Term::Style::BOLD) + "Running tty-cpp version: " + Term::style(Term::Style::RESET) 
-                  + Term::VERSION + '\n' +
-
-                  Term::style(Term::Style::BOLD) + "Repo: " + Term::style(Term::Style::RESET)
-                  + Term::REPO + "\n\n" +
-
-                  "This test is quite clunky, buggy, and the code is... well less then perfect. This test was written to demonstrate\nwhat is possible using TTY-CPP. This test will be improved as TTY-CPP evolves into a more mature library.\n\n" +
-
-                  Term::color_fg(Term::ColorBit4::GRAY) + "press enter to acknowledge" + Term::color_fg(Term::ColorBit4::DEFAULT));
+            const Term::CellStyle bold = Term::CellStyle().with(Term::Style::BOLD);
+            Term::Text msg;
+            msg.append("Running tty-cpp version: ", bold).append(Term::VERSION + '\n')
+               .append("Repo: ", bold).append(Term::REPO + "\n\n")
+               .append("This test is quite clunky, buggy, and the code is... well less then perfect. This test was written to demonstrate\nwhat is possible using TTY-CPP. This test will be improved as TTY-CPP evolves into a more mature library.\n\n")
+               .append("press enter to acknowledge", Term::CellStyle(Term::ColorBit4::GRAY));
+            alert("INFO", "ACKNOWLEDGE", msg);
             Screen::restore();
         }
     }
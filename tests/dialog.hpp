@@ -17,50 +17,42 @@ void die(int status = 0) {
     exit(status);
 }
 
+// the box is drawn into a buffer of its own size and written out at once, one row per cursor move
 void box(int row,   int column,
          int width, int height,
-         std::string topLeft     = "┌",
-         std::string topRight    = "┐",
-         std::string bottomLeft  = "└",
-         std::string bottomRight = "┘",
-         std::string dash        = "─",
-         std::string pipe        = "│") {
-    cursor_pos_t oldpos = Cursor::position();
-
-    std::string spaces  (width-2, ' ');
+         Term::BorderStyle border = Term::BorderStyle::SINGLE) {
+    Term::CellBuffer buffer;
+    buffer.resize(height, width);
+    Term::draw_box(buffer, Term::Box{0, 0, height, width, border});
 
+    std::string out = "\0337";
     for (int i = 0; i < height; i++) {
-        Cursor::set(row + i, column);
-        if (i == 0) {
-            std::cout << topLeft;
-            for (int j = 2; j < width; j++) std::cout << dash;
-            std::cout << topRight;
-        } else if (i == height-1) {
-            std::cout << bottomLeft;
-            for (int j = 2; j < width; j++) std::cout << dash;
-            std::cout << bottomRight;
-        } else { 
-            std::cout << pipe << spaces << pipe;
-        }
+        out += "\033[" + std::to_string(row + i) + ';' + std::to_string(column) + 'H';
+        for (int j = 0; j < width; j++)
+            Term::utf8_append(out, buffer.at(i, j).glyph);
     }
-    Cursor::set(oldpos);
+    std::cout << out << "\0338" << std::flush;
 }
 
-void alert(const std::string& type, const std::string& action, const std::string& msg) {
+void alert(const std::string& type, const std::string& action, const Term::Text& msg) {
     RawModeGuard raw_mode_guard;
-    std::vector<std::string> split_msg;
-    std::istringstream iss(msg);
-    std::string line;
+    std::vector<Term::TextView> split_msg;
+    std::size_t start = 0, end;
 
-    while (std::getline(iss, line)) 
-        split_msg.push_back(line);
+    // views of msg, each line keeps its styles
+    while ((end = msg.content().find('\n', start)) != std::string_view::npos) {
+        split_msg.push_back(msg.substr(start, end - start));
+        start = end + 1;
+    }
+    if (start < msg.size())
+        split_msg.push_back(msg.substr(start));
 
-    auto longest_string = std::max_element(split_msg.begin(), split_msg.end(),
-        [](const std::string& a, const std::string& b) {
-            return a.size() < b.size();
-        });
+    // in columns, bytes would count "│" as 3 and "漢" as 3
+    std::size_t longest = 0;
+    for (const Term::TextView& line : split_msg)
+        longest = std::max(longest, line.width());
 
-    int width = longest_string->size() + 4;
+    int width = longest + 4;
     int height = split_msg.size() + 4;
 
     Screen::Size term_size = Screen::size();
@@ -76,12 +68,12 @@ void alert(const std::string& type, const std::string& action, const std::string
               << type 
               << Term::style(Term::Style::RESET) << " ├";
 
-    for (int line = 0; line < split_msg.size(); line++) {
+    for (std::size_t line = 0; line < split_msg.size(); line++) {
         Cursor::set((y + 2) + line, x + 2);
         std::cout << split_msg[line];
     }
 
-    Cursor::set(y + (height - 1), (x + floor(width / 2) - floor(button_text.length() / 2))-1);
+    Cursor::set(y + (height - 1), (x + floor(width / 2) - floor(Term::display_width(action) / 2))-1);
     std::cout << "┤"
               << Term::style(Term::Style::REVERSE) 
               << action 
@@ -0,0 +1,60 @@
+/* frame_alloc -- counts heap allocations per frame, steady state rendering should make none. */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/tty-cpp.hpp"
+
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// one frame of a status board: a header, colored rows and a ticking counter
+static void draw(Term::Renderer& renderer, int frame) {
+    Term::Arena& arena = Term::frame_arena();
+    Term::CellBuffer& buffer = renderer.buffer();
+    const Term::CellStyle header(Term::ColorBit4::BLACK, Term::ColorBit4::CYAN);
+
+    buffer.fill(0, 0, 1, buffer.columns(), Term::Cell{U' ', header});
+    buffer.print(0, 1, arena.concat({"frame_alloc ", arena.repeat("─", 10)}), header.with(Term::Style::BOLD));
+
+    char number[16];
+    for (std::size_t row = 1; row < buffer.rows(); row++) {
+        const int length = std::snprintf(number, sizeof(number), "%d", frame + static_cast<int>(row));
+        const Term::CellStyle style(Term::Color::index(static_cast<std::uint8_t>(16 + (frame + row) % 8)));
+        buffer.print(row, 2, arena.concat({"row ", std::string_view(number, length), " é"}), style);
+    }
+    renderer.present();
+}
+
+int main() {
+    // render into /dev/null, only the allocations matter here
+    const int null_fd = open("/dev/null", O_WRONLY);
+    Term::Terminal terminal(STDIN_FILENO, null_fd);
+    Term::Renderer renderer(terminal, 50, 200);
+
+    const int warmup = 10, frames = 100;
+    for (int frame = 0; frame < warmup; frame++)
+        draw(renderer, frame);
+
+    allocations = 0;
+    for (int frame = warmup; frame < warmup + frames; frame++)
+        draw(renderer, frame);
+
+    std::printf("%zu heap allocations in %d frames after warming up\n", allocations, frames);
+    close(null_fd);
+    return allocations == 0 ? 0 : 1;
+}
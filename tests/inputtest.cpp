@@ -20,26 +20,51 @@ std::string key_name(Key key) {
     }
 }
 
+std::string mouse_name(const Term::MouseEvent& mouse) {
+    static const char* buttons[] = {"LEFT", "MIDDLE", "RIGHT", "NONE", "WHEEL UP", "WHEEL DOWN", "WHEEL LEFT", "WHEEL RIGHT", "BACK", "FORWARD"};
+    static const char* actions[] = {"PRESS", "RELEASE", "DRAG", "MOVE"};
+
+    return std::string(buttons[static_cast<int>(mouse.button)]) + ' ' + actions[static_cast<int>(mouse.action)]
+           + " at " + std::to_string(mouse.row) + ';' + std::to_string(mouse.column);
+}
+
 int main() {
     RawModeGuard raw_mode_guard;
     
-    std::cout << Term::style(Term::Style::BOLD) << "Running tty-cpp version: " << Term::style(Term::Style::RESET) << Term::VERSION 
-              << Term::style(Term::Style::BOLD) << "\nRepo: " << Term::style(Term::Style::RESET) << Term::REPO 
-              << std::endl << std::endl;
+    Term::print(TERM_MARKUP("{bold}Running tty-cpp version:{/} {}\n{bold}Repo:{/} {}\n\n"), Term::VERSION, Term::REPO);
 
-    if (Term::stdout_connected()) 
-        std::cout << Term::color_fg(Term::ColorBit4::GREEN) << "Standard output is attached to a terminal." << std::endl << std::endl;
+    if (Term::stdout_connected())
+        Term::print(TERM_MARKUP("{green}Standard output is attached to a terminal.{/}\n\n"));
     else
-        std::cout << Term::color_fg(Term::ColorBit4::RED) << "Standard output is not attached to a terminal." << std::endl << std::endl;
-    std::cout << Term::color_fg(Term::ColorBit4::DEFAULT);
+        Term::print(TERM_MARKUP("{red}Standard output is not attached to a terminal.{/}\n\n"));
     
+    Term::enable_kitty_keyboard(Term::KITTY_DISAMBIGUATE | Term::KITTY_REPORT_EVENTS);
+    Term::enable_mouse(Term::MouseMode::DRAG);
+    Term::set_motion_coalescing(true);
+
     while (true) {
-        Key pressed_key = Term::getkey();
+        Term::Event event = Term::getevent();
 
-        std::cout << "Key pressed: " << key_name(pressed_key) << std::endl;
-        if (pressed_key == Key::CTRL_C)
+        if (event.type == Term::EventType::MOUSE) {
+            std::cout << "Mouse: " << mouse_name(event.mouse) << std::endl;
+            continue;
+        }
+
+        if (event.action == Term::KeyAction::RELEASE)
+            continue;
+        if (event.action == Term::KeyAction::REPEAT)
+            std::cout << "(repeat) ";
+
+        if (event.key == Key::UNKNOWN && event.codepoint != 0)
+            std::cout << "Character typed: " << Term::utf8_encode(event.codepoint) << " (U+" << std::hex << event.codepoint << std::dec << ')' << std::endl;
+        else
+            std::cout << "Key pressed: " << key_name(event.key) << std::endl;
+        if (event.key == Key::CTRL_C || event.type == Term::EventType::NONE)
             break; // Exit the loop
     }
 
+    Term::disable_mouse();
+    Term::disable_kitty_keyboard();
+
     return 0;
 }
@@ -17,7 +17,12 @@
 #include <vector>
 #include <algorithm>
 #include <optional>
-#include "table.hpp"
+#include <array>
+#include <deque>
+#include <string_view>
+#include "../include/tty-cpp.hpp"
+
+using namespace std;
 
 // default values for optional args
 #define _NOCOLOR   false
@@ -522,41 +527,37 @@ int main(int argc, char **argv) {
     }
 
 
-    TableStyle style("│", "─", "─", "├", "┤", "╭", "╮", "╰", "╯", ' ');
-    if (NOTABLE) {
-        style = TableStyle("", "", "", "", "", "", "", "", "", ' ');
-    } else if (NOUNICODE) {
-        style = TableStyle("|", "-", "-", "+", "+", "+", "+", "+", "+", ' ');
-    }
-    
-    Table table({}, style);
+    Term::Table table(NOUNICODE ? Term::BorderStyle::ASCII : Term::BorderStyle::ROUNDED);
+    table.set_borders(!NOTABLE);
         
     if (!NOHEADER) {
-        table.set_headers({"Process Name", "PID", "Process State", "CPU Usage (secs)", "Memory Usage (KB)", "Parent Process"}, true);
+        table.set_headers({"Process Name", "PID", "Process State", "CPU Usage (secs)", "Memory Usage (KB)", "Parent Process"}, Term::Table::Align::CENTER);
     }
     
-    std::vector<std::string> row;
+    // the table only keeps views of the text, the rows live here until it is printed
+    std::deque<std::array<std::string, 6>> rows;
 
     for (pid_t pid : PIDS) {
+        std::array<std::string, 6>& row = rows.emplace_back();
         std::string pidpath = get_process_path(pid);
-        row.push_back(SHOWPATH ? PIDPATH : basename(pidpath));
-        row.push_back(std::to_string(pid));
+        row[0] = SHOWPATH ? pidpath : basename(pidpath);
+        row[1] = std::to_string(pid);
     
         switch (get_process_state(pid)) {
-            case ProcessState::Running: row.push_back("Running"); break;
-            case ProcessState::Stopped: row.push_back("Stopped"); break;
-            case ProcessState::NotRunning: row.push_back("Not Running"); break;
-            case ProcessState::Suspended: row.push_back("Suspended"); break;
+            case ProcessState::Running: row[2] = "Running"; break;
+            case ProcessState::Stopped: row[2] = "Stopped"; break;
+            case ProcessState::NotRunning: row[2] = "Not Running"; break;
+            case ProcessState::Suspended: row[2] = "Suspended"; break;
         }
 
-        row.push_back(std::to_string(get_cpu_usage(pid)));
-        row.push_back(std::to_string(get_memory_usage(pid)));
-        row.push_back(std::to_string(get_parent_pid(pid)));
+        row[3] = std::to_string(get_cpu_usage(pid));
+        row[4] = std::to_string(get_memory_usage(pid));
+        row[5] = std::to_string(get_parent_pid(pid));
 
-        table.add_row(row);
-        row.clear();
+        const std::string_view cells[] = {row[0], row[1], row[2], row[3], row[4], row[5]};
+        table.add_row(cells, 6);
     }
-    table.print(); // need to create a color system :)
+    table.print(std::cout); // need to create a color system :)
 
     return 0;
 }
@@ -0,0 +1,318 @@
+/* render_check -- draws random frames (scrolls, fills, text, wide glyphs) and replays what the renderer wrote on a
+   small VT emulator. after every frame the emulated screen has to match the buffer, serially and in row bands
+   on 4 threads. */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../include/tty-cpp.hpp"
+
+// the part of a VT terminal the renderer uses: CUP, CUF, EL, ECH, ED, SGR, REP, DECSTBM, SU, SD, IL and DL
+class Emulator {
+public:
+    Emulator(int rows, int columns)
+        : rows_(rows), columns_(columns), bottom_(rows), glyphs_(rows * columns, " "), pens_(rows * columns) {}
+
+    const std::string& glyph(int row, int column) const { return glyphs_[row * columns_ + column]; }
+    const std::string& pen(int row, int column) const { return pens_[row * columns_ + column]; }
+
+    // the pen a style leaves after a reset, in the form pen() has
+    static std::string pen_of(const Term::CellStyle& style) {
+        std::string sgr;
+        Term::append_sgr(sgr, Term::CellStyle(), style);
+        Emulator emulator(1, 1);
+        emulator.feed(sgr);
+        return emulator.current_pen();
+    }
+    // just the background of a pen, which is all an erased cell keeps
+    static std::string background(const std::string& pen) {
+        const std::size_t first = pen.find('|');
+        return pen.substr(first + 1, pen.find('|', first + 1) - first - 1);
+    }
+
+    void feed(const std::string& text) {
+        for (std::size_t i = 0; i < text.size();) {
+            const unsigned char byte = static_cast<unsigned char>(text[i]);
+            if (byte == '\033') {
+                i = escape(text, i);
+                continue;
+            }
+            const std::size_t length = byte < 0x80 ? 1 : byte < 0xe0 ? 2 : byte < 0xf0 ? 3 : 4;
+            put(text.substr(i, length));
+            i += length;
+        }
+    }
+
+private:
+    int rows_, columns_;
+    int row_{0}, column_{0};
+    int top_{0}, bottom_; // the scrolling region, bottom_ past its last row
+    bool wrap_{false};    // the last column was written, the next glyph goes on the next row
+    std::vector<std::string> glyphs_; // "<T>" for the second half of a wide glyph
+    std::vector<std::string> pens_;
+    std::string last_; // for REP
+    std::string foreground_, background_;
+    std::vector<int> attributes_;
+
+    std::string current_pen() const {
+        std::string pen = foreground_ + "|" + background_ + "|";
+        for (int attribute : attributes_)
+            pen += std::to_string(attribute) + ",";
+        return pen;
+    }
+
+    static void fail(const char* what, char c) {
+        std::printf("emulator: %s %c\n", what, c);
+        std::exit(1);
+    }
+
+    void sgr(std::vector<int> params) {
+        if (params.empty())
+            params.push_back(0);
+        for (std::size_t i = 0; i < params.size(); i++) {
+            const int p = params[i];
+            if (p == 0) {
+                foreground_.clear();
+                background_.clear();
+                attributes_.clear();
+            } else if ((p >= 30 && p <= 37) || (p >= 90 && p <= 97) || p == 39) {
+                foreground_ = p == 39 ? "" : std::to_string(p);
+            } else if ((p >= 40 && p <= 47) || (p >= 100 && p <= 107) || p == 49) {
+                background_ = p == 49 ? "" : std::to_string(p);
+            } else if (p == 38 || p == 48) {
+                std::string color = std::to_string(p);
+                const std::size_t count = params.at(i + 1) == 5 ? 2 : 4;
+                for (std::size_t k = 1; k <= count; k++)
+                    color += ";" + std::to_string(params.at(i + k));
+                i += count;
+                (p == 38 ? foreground_ : background_) = color;
+            } else if (std::find(attributes_.begin(), attributes_.end(), p) == attributes_.end()) {
+                attributes_.insert(std::upper_bound(attributes_.begin(), attributes_.end(), p), p);
+            }
+        }
+    }
+
+    void blank(int row, int from, int to, const std::string& pen) {
+        for (int column = std::max(from, 0); column < std::min(to, columns_); column++) {
+            glyphs_[row * columns_ + column] = " ";
+            pens_[row * columns_ + column] = pen;
+        }
+    }
+    // erasing keeps the background only
+    void erase(int row, int from, int to) { blank(row, from, to, "|" + background_ + "|"); }
+
+    // rows from..to (past the end) move up by lines, or down when lines is negative
+    void scroll(int from, int to, int lines) {
+        for (; lines > 0; lines--) {
+            std::move(glyphs_.begin() + (from + 1) * columns_, glyphs_.begin() + to * columns_, glyphs_.begin() + from * columns_);
+            std::move(pens_.begin() + (from + 1) * columns_, pens_.begin() + to * columns_, pens_.begin() + from * columns_);
+            blank(to - 1, 0, columns_, "||");
+        }
+        for (; lines < 0; lines++) {
+            std::move_backward(glyphs_.begin() + from * columns_, glyphs_.begin() + (to - 1) * columns_, glyphs_.begin() + to * columns_);
+            std::move_backward(pens_.begin() + from * columns_, pens_.begin() + (to - 1) * columns_, pens_.begin() + to * columns_);
+            blank(from, 0, columns_, "||");
+        }
+    }
+
+    // a wide glyph loses its other half when either one is written over
+    void split_wide(int column) {
+        std::string* row = &glyphs_[row_ * columns_];
+        if (row[column] == "<T>" && column > 0)
+            row[column - 1] = " ";
+        if (column + 1 < columns_ && row[column + 1] == "<T>")
+            row[column + 1] = " ";
+    }
+
+    void put(const std::string& glyph) {
+        if (wrap_) {
+            wrap_ = false;
+            column_ = 0;
+            if (row_ == bottom_ - 1)
+                scroll(top_, bottom_, 1);
+            else
+                row_++;
+        }
+
+        char32_t codepoint = 0;
+        Term::utf8_decode(glyph.data(), glyph.size(), codepoint);
+        const bool wide = Term::codepoint_width(codepoint) == 2;
+        if (wide && column_ == columns_ - 1)
+            fail("wide glyph in the last column", ' ');
+
+        split_wide(column_);
+        if (wide)
+            split_wide(column_ + 1);
+        glyphs_[row_ * columns_ + column_] = glyph;
+        pens_[row_ * columns_ + column_] = current_pen();
+        if (wide) {
+            column_++;
+            glyphs_[row_ * columns_ + column_] = "<T>";
+            pens_[row_ * columns_ + column_] = current_pen();
+        }
+        last_ = glyph;
+        if (column_ == columns_ - 1)
+            wrap_ = true;
+        else
+            column_++;
+    }
+
+    // the index past the sequence at text[i]
+    std::size_t escape(const std::string& text, std::size_t i) {
+        if (i + 1 >= text.size() || text[i + 1] != '[')
+            fail("unknown escape", i + 1 < text.size() ? text[i + 1] : ' ');
+
+        std::size_t j = i + 2;
+        const bool private_mode = j < text.size() && text[j] == '?';
+        if (private_mode)
+            j++;
+        std::vector<int> params;
+        int param = -1;
+        for (; j < text.size() && ((text[j] >= '0' && text[j] <= '9') || text[j] == ';'); j++) {
+            if (text[j] == ';') {
+                params.push_back(std::max(param, 0));
+                param = -1;
+            } else {
+                param = std::max(param, 0) * 10 + (text[j] - '0');
+            }
+        }
+        if (param >= 0)
+            params.push_back(param);
+        if (j >= text.size())
+            fail("sequence cut short", ' ');
+        if (private_mode) // cursor visibility, synchronized output: nothing on the screen
+            return j + 1;
+
+        const int first = params.empty() ? 0 : params[0];
+        const int count = first != 0 ? first : 1;
+        const int second = params.size() > 1 ? params[1] : 0;
+        switch (text[j]) {
+            case 'H': row_ = count - 1; column_ = (second != 0 ? second : 1) - 1; wrap_ = false; break;
+            case 'C': column_ = std::min(columns_ - 1, column_ + count); wrap_ = false; break;
+            case 'K': erase(row_, column_, columns_); wrap_ = false; break;
+            case 'X': erase(row_, column_, column_ + count); wrap_ = false; break;
+            case 'J':
+                for (int row = 0; row < rows_; row++)
+                    erase(row, 0, columns_);
+                break;
+            case 'm': sgr(params); break;
+            case 'b':
+                for (int k = 0; k < count; k++)
+                    put(last_);
+                break;
+            case 'r':
+                top_ = count - 1;
+                bottom_ = second != 0 ? second : rows_;
+                row_ = column_ = 0;
+                wrap_ = false;
+                break;
+            case 'S': scroll(top_, bottom_, count); break;
+            case 'T': scroll(top_, bottom_, -count); break;
+            case 'M': scroll(row_, bottom_, count); column_ = 0; wrap_ = false; break;
+            case 'L': scroll(row_, bottom_, -count); column_ = 0; wrap_ = false; break;
+            default: fail("unknown CSI", text[j]);
+        }
+        return j + 1;
+    }
+};
+
+static bool matches(const Emulator& emulator, Term::CellBuffer& buffer) {
+    for (std::size_t row = 0; row < buffer.rows(); row++) {
+        for (std::size_t column = 0; column < buffer.columns(); column++) {
+            const Term::Cell cell = buffer.at(row, column);
+            std::string glyph;
+            if (cell.glyph == Term::CellBuffer::WIDE_TAIL)
+                glyph = "<T>";
+            else if (cell.glyph & Term::GraphemePool::INTERNED)
+                glyph = std::string(Term::graphemes().get(cell.glyph));
+            else
+                glyph = Term::utf8_encode(cell.glyph);
+
+            const int r = static_cast<int>(row), c = static_cast<int>(column);
+            const std::string want = Emulator::pen_of(cell.style), got = emulator.pen(r, c);
+            // a blank may have been erased instead of written, then only its background shows
+            const bool blank = glyph == " " && !cell.style.attrs;
+            if (emulator.glyph(r, c) != glyph || (blank ? Emulator::background(got) != Emulator::background(want) : got != want)) {
+                std::printf("at %zu,%zu the screen has '%s' [%s], the buffer '%s' [%s]\n", row, column,
+                            emulator.glyph(r, c).c_str(), got.c_str(), glyph.c_str(), want.c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    // the renderer writes into a temporary file, read back after each frame
+    std::FILE* file = std::tmpfile();
+    const int fd = fileno(file);
+    off_t read_up_to = 0;
+    auto written = [&] {
+        std::string out;
+        char chunk[65536];
+        ssize_t n;
+        while ((n = pread(fd, chunk, sizeof(chunk), read_up_to)) > 0) {
+            out.append(chunk, static_cast<std::size_t>(n));
+            read_up_to += n;
+        }
+        return out;
+    };
+
+    const int rows = 60, columns = 300; // big enough to be split in bands
+    const Term::CellStyle styles[] = {
+        Term::CellStyle(),
+        Term::CellStyle(Term::ColorBit4::RED),
+        Term::CellStyle(Term::ColorBit4::RED).with(Term::Style::BOLD),
+        Term::CellStyle(Term::Color(1, 2, 3), Term::Color::index(33)),
+        Term::CellStyle(Term::Color(), Term::ColorBit4::BLUE),
+        Term::CellStyle().with(Term::Style::UNDERLINE)};
+
+    for (std::size_t threads : {1, 4}) {
+        Term::Terminal terminal(STDIN_FILENO, fd);
+        Term::Renderer renderer(terminal, rows, columns);
+        renderer.use_threads(threads);
+        renderer.use_repeat(true); // the emulator knows REP
+        Emulator emulator(rows, columns);
+        written(); // whatever setting up the renderer wrote
+
+        std::mt19937 random(static_cast<unsigned>(threads));
+        auto below = [&](int n) { return static_cast<int>(random() % static_cast<unsigned>(n)); };
+        for (int frame = 0; frame < 60; frame++) {
+            Term::CellBuffer& buffer = renderer.buffer();
+            const int change = below(5);
+            if (change == 0)
+                buffer.scroll(below(10), rows - below(10), below(7) - 3);
+            if (change == 1)
+                buffer.fill(below(rows), below(columns), below(20), below(100),
+                            Term::Cell{static_cast<std::uint32_t>('a' + below(3)), styles[below(6)]});
+            for (int k = 0; k < 30; k++) {
+                std::string text;
+                for (int length = below(40); length > 0; length--)
+                    text += below(4) == 0 ? ' ' : static_cast<char>('a' + below(26));
+                buffer.print(below(rows), below(columns), text, styles[below(6)]);
+            }
+            if (change == 2) { // everything one row down, for the scroll detection
+                for (int row = rows - 1; row > 0; row--)
+                    for (int column = 0; column < columns; column++)
+                        buffer.set(row, column, buffer.at(row - 1, column));
+                buffer.print(0, 0, "fresh line " + std::to_string(frame));
+            }
+            if (change == 3)
+                buffer.print(below(rows), 0, "é────────── 😀", styles[2]);
+
+            renderer.present();
+            emulator.feed(written());
+            if (!matches(emulator, renderer.buffer())) {
+                std::printf("frame %d with %zu threads differs\n", frame, threads);
+                return 1;
+            }
+        }
+        std::printf("%zu threads: the screen matched the buffer after every frame\n", threads);
+    }
+    std::fclose(file);
+    return 0;
+}
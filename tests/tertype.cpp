@@ -4,9 +4,12 @@
 #include <vector>
 #include <cmath>
 #include <iomanip>
-//#include <chrono>
+#include <variant>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string_view>
 #include <thread>
-#include <mutex>
 #include "../include/tty-cpp.hpp"
 
 #define VERSION "0.1"
@@ -76,17 +79,6 @@ void fill_screen(char c, size_t r, size_t g, size_t b) {
     fill_screen(c, Term::rgb(r, g, b)); 
 }
 
-std::string repeat_str(const std::string& str, const size_t n) {
-    std::string result;
-    result.reserve(n * str.length());
-    
-    for (size_t i = 0; i < n; ++i) {
-        result += str;
-    }
-    
-    return result;
-}
-
 int _word_count(const std::string& s) {
     int word_count = 1;
     
@@ -116,8 +108,6 @@ class Typer {
         }
 
         void handle_key(Key key) {
-            std::lock_guard<std::mutex> lock(display_mutex); // lock mutex
-            
             if (pointer < text.size() && text.at(pointer) == static_cast<char>(key)) {
                 if (pointer == text.size() - 1)
                     safe_exit();
@@ -140,44 +130,50 @@ class Typer {
         }
 
         void display() {
-            std::lock_guard<std::mutex> lock(display_mutex); // lock mutex
-            
+            // every temporary string of the frame lives in the arena, nothing is allocated per frame
+            Term::Arena& arena = Term::frame_arena();
+            const std::string_view view = text;
+
             Cursor::set(round(term_size.rows / 2) - 2, 0);
 
-            std::cout << Term::color_fg(FGBORDERCOLOR) << Term::color_bg(BGFILLCOLOR);
-            std::cout << repeat_str("─", round(term_size.columns / 2)) << "┬" << repeat_str("─", round(term_size.columns / 2)) << std::endl;
+            std::cout << Term::color_fg(arena, FGBORDERCOLOR) << Term::color_bg(arena, BGFILLCOLOR);
+            std::cout << arena.repeat("─", round(term_size.columns / 2)) << "┬" << arena.repeat("─", round(term_size.columns / 2)) << std::endl;
             Cursor::next_line();
-            std::cout << repeat_str("─", round(term_size.columns / 2)) << "┴" << repeat_str("─", round(term_size.columns / 2));
+            std::cout << arena.repeat("─", round(term_size.columns / 2)) << "┴" << arena.repeat("─", round(term_size.columns / 2));
             Cursor::prev_line();
 
-            std::cout << repeat_str(" ", round(term_size.columns / 2) - ((pointer) - spos)) // space before text 
+            std::cout << arena.repeat(" ", std::max(0.0, round(term_size.columns / 2) - ((pointer) - spos))) // space before text 
                       /* TEXT BEFORE CHAR */
-                      << Term::color_fg(BEFORCHARCOLOR)
-                      << text.substr(spos, (pointer) - spos)
-                      << Term::style(Term::Style::RESET)
+                      << Term::color_fg(arena, BEFORCHARCOLOR)
+                      << view.substr(spos, (pointer) - spos)
+                      << Term::style(arena, Term::Style::RESET)
                       /********************/
 
                       /* ON CHAR */
-                      << (text.at(pointer) == ' ' ? Term::color_bg(CURRENTCHARCOLOR) : Term::color_fg(CURRENTCHARCOLOR)) 
-                      << Term::style(Term::Style::BOLD)
+                      << (text.at(pointer) == ' ' ? Term::color_bg(arena, CURRENTCHARCOLOR) : Term::color_fg(arena, CURRENTCHARCOLOR)) 
+                      << Term::style(arena, Term::Style::BOLD)
                       << text.at(pointer)
-                      << Term::style(Term::Style::RESET)
+                      << Term::style(arena, Term::Style::RESET)
                       /***********/
 
                       /* TEXT AFTER CHAR */
-                      << Term::color_fg(AFTERCHARCOLOR) 
-                      << text.substr(pointer + 1, round(term_size.columns / 2))
+                      << Term::color_fg(arena, AFTERCHARCOLOR) 
+                      << view.substr(pointer + 1, round(term_size.columns / 2))
                       /*******************/
 
-                      << repeat_str(" ", round(term_size.columns / 2) - (text.size() - (pointer))) // space after text
+                      << arena.repeat(" ", std::max(0.0, round(term_size.columns / 2) - (text.size() - (pointer)))) // space after text
 
                       // reset color and flush
-                      << Term::style(Term::Style::RESET) << std::flush;
+                      << Term::style(arena, Term::Style::RESET) << std::flush;
+
+            arena.reset(); // tertype draws straight to std::cout, there is no Renderer::present() to do it
+        }
+
+        void resize() {
+            term_size = Screen::size(); // cached, refreshed by the library on SIGWINCH
         }
 
         void display_status() {
-            std::lock_guard<std::mutex> lock(display_mutex); // lock mutex
-            
             Cursor::set(term_size.rows - 2, 0);
             std::cout << "WORD_COUNT: " << word_count << " WORDS_DONE: " << words_done;
             Cursor::next_line();
@@ -185,8 +181,6 @@ class Typer {
         }
 
         //void display_wpm() {
-        //    std::lock_guard<std::mutex> lock(display_mutex); // lock mutex
-        
         //    Cursor::set(round(term_size.rows / 2) - 4, 0);
         //    std::cout << "WPM: " << wpm;
         //}
@@ -206,9 +200,6 @@ class Typer {
         // used for real time WPM tracking
         //double wpm = 0.0;
         //std::chrono::time_point<std::chrono::steady_clock> last_word_time;
-    
-        // mutex to prevent concurrent access to std::cout
-        std::mutex display_mutex;
 };
 
 int main() {
@@ -218,26 +209,51 @@ int main() {
 
     fill_screen(' ', BGFILLCOLOR);
 
-    std::cout << Term::style(Term::Style::BOLD) << "TerType " << Term::style(Term::Style::RESET) << "- V" << VERSION;
+    Term::print(TERM_MARKUP("{bold}TerType{/} - V{}"), VERSION);
 
     std::string text = "Hello, World! This is a TypeRacer clone in the terminal! This isn't the most fancy thing ever. It's just designed to show off the stuff you can do using tty-cpp. Try it out sometime!";
     Typer typer(text);
-    
-    Key key = Key::NUL;
 
-    // start timer thread
-    std::thread timer([&]() {
-        while (true) {
-            typer.display_status();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // keys go from this thread to the render thread through a lock-free queue,
+    // only the render thread touches the typer and the terminal
+    Term::SpscQueue<Term::Event, 64> keys;
+    std::atomic<bool> running{true};
+
+    std::thread render([&]() {
+        auto next_status = std::chrono::steady_clock::now();
+        Term::Event event;
+
+        typer.display();
+        while (running.load(std::memory_order_relaxed)) {
+            bool dirty = false;
+            while (keys.pop(event)) {
+                if (event.type == Term::EventType::RESIZE) {
+                    typer.resize();
+                    fill_screen(' ', BGFILLCOLOR);
+                } else {
+                    typer.handle_key(event.key);
+                }
+                dirty = true;
+            }
+            if (dirty)
+                typer.display();
+
+            if (std::chrono::steady_clock::now() >= next_status) {
+                typer.display_status();
+                next_status += std::chrono::milliseconds(100);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
     });
 
-    do {
-        typer.handle_key(key);
-        typer.display();
-    } while ((key = Term::getkey()) != Key::CTRL_C);
+    Term::Event event;
+    while ((event = Term::getevent()).type != Term::EventType::NONE && event.key != Key::CTRL_C) {
+        if (event.type == Term::EventType::KEY || event.type == Term::EventType::RESIZE)
+            while (!keys.push(event)) std::this_thread::yield();
+    }
 
+    running = false;
+    render.join();
     safe_exit();
 
     return 0;